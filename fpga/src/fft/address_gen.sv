@@ -0,0 +1,141 @@
+// address_gen.sv - Address generation for an N-point FFT (M = log2(N) address bits)
+
+// Read addresses for every lane (lane i takes butterfly lanes*iter + i).
+// size is log2 of the transform being run, up to M: a smaller transform uses
+// the low size address bits, and its twiddles are in its own (size-point)
+// index space. load_size is the same for the frame being loaded, which may
+// differ from the one computing. Twiddles come from their own level and
+// iteration, so they can be looked up ahead of the reads.
+module agu #(parameter N=512, lanes=1)
+           (input logic [3:0] load_size, size,
+            input logic [$clog2(N)-1:0] fft_level,
+            input logic [$clog2(N)-1:0] butterfly_iter,
+            input logic [$clog2(N)-1:0] twiddle_level,
+            input logic [$clog2(N)-1:0] twiddle_iter,
+            input logic [$clog2(N)-1:0] load_address,
+            output logic [2*lanes-1:0][$clog2(N)-1:0] read_address, // [2*i] = a, [2*i+1] = b
+            output logic [$clog2(N)-1:0] load_address_rev,
+            output logic [lanes-1:0][$clog2(N)-2:0] twiddle_address); // N/2 factors
+
+    localparam M = $clog2(N);
+
+    logic [M-1:0] reversed;
+
+    // first deal with loading address, reversed within the size bits
+    reverse_bits #(M) load_logic(load_address, reversed);
+    assign load_address_rev = reversed >> (M - load_size);
+
+    // then deal with standard processing address
+    genvar i;
+    generate
+        for (i = 0; i < lanes; i++) begin : lane
+            logic [M-1:0] j, j_twiddle;
+
+            assign j = butterfly_iter * lanes + i;
+            assign j_twiddle = twiddle_iter * lanes + i;
+            processing_agu #(N) standard_logic(size, fft_level, j,
+                                               read_address[2*i], read_address[2*i+1], );
+            processing_agu #(N) twiddle_logic(size, twiddle_level, j_twiddle, , , twiddle_address[i]);
+        end
+    endgenerate
+
+endmodule
+
+
+module processing_agu #(parameter N=512)
+                      (input logic [3:0] size,
+                       input logic [$clog2(N)-1:0] fft_level,
+                       input logic [$clog2(N)-1:0] butterfly_iter,
+                       output logic [$clog2(N)-1:0] address_a, address_b,
+                       output logic [$clog2(N)-2:0] twiddle_address);
+
+    localparam M = $clog2(N);
+
+    // intermediate for shifting (M bits)
+    logic [M-1:0] temp_a, temp_b, size_mask;
+    // must be signed for sign extending
+    logic signed [M-1:0] mask, mask_shift;
+
+    always_comb begin
+        size_mask = ~('1 << size);
+
+        // j * 2
+        temp_a = butterfly_iter << 1;
+
+        // Circular shift by the level, within the size bits
+        address_a  = ((temp_a << fft_level) | (temp_a >> (size - fft_level))) & size_mask;
+
+        // j * 2 + 1
+        temp_b = temp_a + 1'b1;
+        address_b  = ((temp_b << fft_level) | (temp_b >> (size - fft_level))) & size_mask;
+
+        // zero out size - 1 - i
+        mask = 1 << (M - 1); // top bit set
+        mask_shift = mask >>> fft_level;
+
+        // mask j
+        twiddle_address = (mask_shift[M-2:0] >> (M - size)) & butterfly_iter[M-2:0];
+    end
+endmodule
+
+// Write-back addresses and enable for the butterfly engine.
+// On radix-2 levels writes go where the reads came from. On radix-2^2 levels
+// (see butterfly_r22) even cycles write the previous group's second column
+// and odd cycles write this group's first column.
+// Both are then delayed by the RAM read (one cycle) plus the butterfly
+// latency (depth, or 2*depth for radix-2^2) so the writes land on the right
+// addresses.
+module write_agu #(parameter N=512, depth=0)
+                 (input logic clk, r4, phase, valid,
+                  input logic [$clog2(N)-1:0] address_a, address_b,
+                  output logic write,
+                  output logic [$clog2(N)-1:0] write_address_a, write_address_b);
+
+    localparam M = $clog2(N);
+
+    logic [M-1:0] even_a, even_b, odd_b;
+    logic [M-1:0] issue_a, issue_b, read_a, read_b, mid_a, mid_b, late_a, late_b;
+    logic         read_valid, mid_valid, late_valid;
+
+    always_ff @(posedge clk) begin
+        if (!phase) begin
+            even_a <= address_a;
+            even_b <= address_b;
+        end else begin
+            odd_b <= address_b;
+        end
+    end
+
+    always_comb begin
+        if (!r4) begin
+            issue_a = address_a;
+            issue_b = address_b;
+        end else if (phase) begin
+            issue_a = even_a;
+            issue_b = address_a;
+        end else begin
+            issue_a = even_b;
+            issue_b = odd_b;
+        end
+    end
+
+    // match the read and butterfly latency
+    delay #(2*M+1, 1)     read_stage(clk, {valid, issue_a, issue_b}, {read_valid, read_a, read_b});
+    delay #(2*M+1, depth) first_stage(clk, {read_valid, read_a, read_b}, {mid_valid, mid_a, mid_b});
+    delay #(2*M+1, depth) second_stage(clk, {mid_valid, mid_a, mid_b}, {late_valid, late_a, late_b});
+
+    assign write           = r4 ? late_valid : mid_valid;
+    assign write_address_a = r4 ? late_a : mid_a;
+    assign write_address_b = r4 ? late_b : mid_b;
+
+endmodule
+
+// reverse bits for address ordering
+module reverse_bits #(parameter width=9)
+                    (input logic [width-1:0] bits_in,
+                     output logic [width-1:0] bits_out);
+
+    always_comb
+        for (int i = 0; i < width; i++) bits_out[i] = bits_in[width-1-i];
+
+endmodule
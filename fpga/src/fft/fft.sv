@@ -0,0 +1,250 @@
+// fft.sv - Top Level
+
+// N is the transform size (64 to 4096, a power of two) and width the bits
+// per real/imaginary part; every address, counter and SPI packet follows them.
+// radix selects the butterfly engine: 4 (radix-2^2, default) or 2
+// pipe_depth is the butterfly pipeline depth (0-3), gauss = 1 selects the
+// 3-multiplier complex product, lanes (1, 2, 4) is the number of radix-2
+// butterflies per cycle (see the table in fft_controller.sv)
+// streaming = 1 swaps the in-place core for the R2SDF pipeline in fft_sdf.sv
+// pairs = 2 double-buffers the in-place core's frame memory (1 to save EBR)
+// bfp = 1 scales the in-place core per pass (block floating point) and sends
+// the frame's exponent as an extra first word ahead of the N results
+// real_input = 1 runs the in-place core at N/2 complex points on pairs of
+// real samples and sends bins 0..N/2 only (see fft_controller.sv); the
+// streaming core always takes complex words
+// sample_bits (8, 12 or 16) is the size of a sample on the wire, packed back
+// to back; sample_coding says how to read it: 0 unsigned, 1 offset binary
+// (ADC midscale is zero), 2 two's complement (see Extend)
+// hop < N overlaps frames: each SPI transaction brings hop new samples and
+// the frame is the last N of them (see fft_in_flop), for STFTs at 50% (N/2)
+// or 75% (N/4) overlap without resending history. hop = 1 works too: every
+// transaction is then a single sample and a new frame.
+// half_spectrum = 1 keeps only bins 0..N/2 of a complex transform: with real
+// samples the rest mirror them, so the output buffer drops them and the SPI
+// readback nearly halves (real_input already sends just those bins)
+// cordic > 0 computes twiddles with that many CORDIC iterations instead of
+// a ROM (no EBR; see twiddle_rom for the accuracy per iteration count)
+// osc_div is the HSOSC divider for the one clock everything but SPI runs on:
+// "0b00" 48 MHz, "0b01" 24 MHz, "0b10" 12 MHz, "0b11" 6 MHz; raise it as far
+// as the timing report for the chosen configuration allows
+//
+// The MCU talks to the link in commands (see fft_spi): write a frame, read
+// the status or the results, and set the mode register, whose fields
+// replace per-function pins:
+// format picks the output format per frame (see fft_format in spectrum.sv):
+// 0 full complex, 1 packed 8+8 complex, 2 16-bit magnitude, 3 8-bit
+// log-magnitude, 4 power, and band energies in 5 mel, 6 1/3-octave or
+// 7 linear bands. The result read shrinks with the word size, and for the
+// band formats to just the bands.
+// bands is the number of filterbank bands (up to N/2 - 1, 40 is typical for
+// mel; 0, the default, leaves the filterbank out, see EBR below) and
+// sample_rate the MCU's sample rate in Hz, which places the mel and
+// 1/3-octave bands (see fft_filterbank). The band tables are for frames of
+// the full size N: at a smaller size (SPI_SET_SIZE) formats 5 to 7 send
+// power, as format 4, with one word per bin.
+// window picks the window applied to each frame's samples on load:
+// 0 rectangular, 1 Hann, 2 Hamming, 3 Blackman-Harris (see window_rom).
+// mag_cordic > 0 computes the magnitude with that many CORDIC vectoring
+// iterations instead of alpha-max-beta-min (see fft_magnitude)
+// accumulate = 1 adds the spectral accumulator to the power-based formats,
+// 3 to 7 (log-magnitude, power and the bands, which are summed from the
+// accumulated power); off by default, see EBR below.
+// averaging picks its mode per frame: 0 off, 1 mean of
+// 2^average_log2 frames (only every 2^average_log2-th frame is sent),
+// 2 exponential smoothing by 2^-smoothing, 3 max-hold (see fft_accumulator)
+// inverse makes the next frame loaded an inverse FFT, scaled by 1/N,
+// on the in-place core (complex frames only; see fft_controller). The link
+// only carries real samples (Extend zeroes the imaginary part), so a
+// spectrum cannot be sent over it: from the MCU the bit gives the inverse
+// transform of a real sequence, nothing more. Inverting a spectrum is only
+// possible at the fft_controller level, with complex words on data_in.
+// The frame size register (SPI_SET_SIZE) picks a smaller transform at run
+// time, n = 64 up to N samples, in the same build: frames are then n
+// samples (hop * n / N per transaction), the in-place core runs an n-point
+// (real_input: n/2) transform in proportionally fewer cycles, and n (or
+// n/2 + 1) result words come back. It needs lanes = 1; the streaming core
+// and lanes > 1 stay at N. hop * n / N has to be a whole number of samples
+// (even with real_input), so an odd hop, or one with too few trailing zero
+// bits, raises the smallest size; smaller sizes are ignored like
+// out-of-range ones. Change it between frames, with none in flight.
+// quad = 1 runs the link on the four qio lines (QUADSPI) instead of sdi/sdo,
+// four bits per clock
+// done rises as each frame of results becomes readable (the output buffer's
+// buf_ready), as an interrupt for the MCU to start the readback on
+//
+// EBR: the UP5K has 30 blocks of 256x16. Counted from the memories the
+// default build infers (not from a place-and-route report), it takes all 30:
+//   frame memory   16   2 pairs x 2 sides x 2 banks of 256x32
+//   result buffer   8   2 banks of 512x32 (fft_out_flop)
+//   sample ring     1   512x8 (fft_in_flop)
+//   window ROM      3   3 tables of 256x16
+//   twiddle ROM     2   the 65-word octant, 32 bits wide
+// So the accumulator and the filterbank are off by default; each needs
+// blocks freed first, e.g. pairs = 1 (-8, the next frame then waits for the
+// transform) or cordic > 0 (-2):
+//   accumulate = 1   +5   512 words of 2*width + 3 bits
+//   bands > 0        +3   the three band tables, 258 x 12 bits each
+// The 8-bit dB table of format 3 is read combinationally, so it is logic.
+module fft #(parameter N=512, width=16, radix=4, pipe_depth=2, gauss=0, lanes=1, streaming=0, pairs=2, bfp=1,
+                       real_input=0, cordic=0, osc_div="0b01", mag_cordic=0,
+                       half_spectrum=0, hop=N, accumulate=0, average_log2=3, smoothing=3, quad=0,
+                       sample_bits=8, sample_coding=0, bands=0, sample_rate=16000)
+           (input logic sck, cs_n, sdi, reset, output logic sdo, done, inout wire [3:0] qio);
+
+    localparam real_mode = real_input && !streaming;
+    localparam CORE_N    = real_mode ? N/2 : N;      // points the core transforms
+    localparam CORE_OUT  = real_mode ? N/2 + 1 : N;  // words the core drains per frame
+    localparam OUT_N     = (real_mode || half_spectrum) ? N/2 + 1 : N;  // result words per frame
+    localparam M         = $clog2(CORE_N);
+    localparam BANDS     = (bands < N/2 - 1) ? bands : N/2 - 1;         // each needs a bin of its own
+    localparam LOAD_LATENCY = 3;  // fft_in_flop: cycles from load_ready seen to the first word
+
+    // log2 of the smallest frame: 64 points, or N where sizes below N are not
+    // supported, and no smaller than hop allows: a frame of n samples brings
+    // hop * n / N new ones, which has to be whole (and even with real_input)
+    function automatic int min_size_of();
+        int shift;
+        if (streaming || lanes > 1) return $clog2(N);
+        for (int s = 6; s < $clog2(N); s++) begin
+            shift = $clog2(N) - s;
+            if (((hop >> shift) << shift) == hop && (hop >> shift) % (1 + real_mode) == 0) return s;
+        end
+        return $clog2(N);
+    endfunction
+
+    localparam MIN_SIZE = min_size_of();
+
+    // Clock Generation: a single clock straight from the oscillator
+    logic clk;
+
+    HSOSC #(osc_div) hf_osc (1'b1, 1'b1, clk);
+
+    // Interconnects
+    logic dataReady, buf_ready, core_done, core_processing, core_load, core_start;
+    logic core_load_ready, core_out_start, in_busy;
+    logic [1:0] ready_sync, inverse_sync;
+    logic [1:0][1:0] window_sync, averaging_sync;
+    logic [1:0][3:0] size_sync;
+    logic frame_pending;
+    logic [M-1:0]       core_rd_adr;
+    logic [2*width-1:0] core_rd_data, core_wd_data;
+    logic [3:0]         core_exponent;
+
+    // formatted results
+    logic [1:0][2:0]    format_sync;
+    logic [2:0]         core_format, frame_format, read_format;
+    logic               fmt_start, fmt_done;
+    logic [3:0]         fmt_exponent;
+    logic [2*width-1:0] fmt_data;
+
+    // SPI side: samples into the input buffer, result words out of the output buffer
+    logic [7:0]                     mode;
+    logic [3:0]                     size;
+    logic [$clog2(OUT_N):0]         out_words;
+    logic [2:0]                     format;
+    logic [1:0]                     window, averaging;
+    logic                           inverse, busy, last_ready;
+    logic [7:0]                     frame_count, frame_gray;
+    logic                           sample_write;
+    logic [$clog2(N)-1:0]           sample_index;
+    logic [sample_bits-1:0]         sample;
+    logic [$clog2(N)+1:0]           out_word;
+    logic [2*width-1:0]             out_data;
+
+    // SPI
+    generate
+        if (quad) begin : qspi_link
+            logic [3:0] qio_out;
+            logic       qio_oe;
+
+            fft_spi #(N, width, hop, 4, sample_bits, MIN_SIZE) qspi(sck, cs_n, reset, qio, qio_out, qio_oe, read_format,
+                                                                    {busy, frame_gray}, mode, size, sample_write,
+                                                                    sample_index, sample, dataReady, out_word, out_data);
+            assign qio = qio_oe ? qio_out : 'z;
+            assign sdo = 0;
+        end else begin : spi_link
+            logic sdo_oe;
+
+            fft_spi #(N, width, hop, 1, sample_bits, MIN_SIZE) spi(sck, cs_n, reset, sdi, sdo, sdo_oe, read_format,
+                                                                   {busy, frame_gray}, mode, size, sample_write,
+                                                                   sample_index, sample, dataReady, out_word, out_data);
+            assign qio = 'z;
+        end
+    endgenerate
+
+    assign {format, window, averaging, inverse} = mode;
+
+    // Status for the link: busy from a frame's arrival until its transform
+    // ends, and a count of frames completed into the output buffer (Gray
+    // coded, as the link samples it on sck)
+    assign busy = frame_pending || core_load || core_processing;
+
+    always_ff @(posedge clk) begin
+        last_ready <= buf_ready;
+        if (reset)                       frame_count <= 0;
+        else if (buf_ready && !last_ready) frame_count <= frame_count + 1'b1;
+        frame_gray <= frame_count ^ (frame_count >> 1);
+        done <= buf_ready;
+    end
+
+    // Take each SPI frame once: dataReady stays high until more bits arrive
+    always_ff @(posedge clk) begin
+        ready_sync <= {ready_sync[0], dataReady};
+        format_sync <= {format_sync[0], format};
+        window_sync <= {window_sync[0], window};
+        averaging_sync <= {averaging_sync[0], averaging};
+        inverse_sync <= {inverse_sync[0], inverse};
+        size_sync <= {size_sync[0], size};
+        if (reset || core_load) frame_pending <= 0;
+        else if (ready_sync == 2'b01) frame_pending <= 1;
+    end
+
+    // Buffers
+    // a new frame loads whenever the core has a free buffer, so loading
+    // overlaps both the transform and the drain of the previous result
+    assign in_busy = !core_load_ready;
+
+    // the band tables are for full-size frames; a smaller frame would fill
+    // fewer bands than the output buffer waits for, so it gets power instead
+    assign core_format = (format_sync[1] >= 3'd5 && size_sync[1] != $clog2(N)) ? 3'd4 : format_sync[1];
+
+    // result words per frame of the current size and format
+    assign out_words = (BANDS > 0 && frame_format >= 3'd5)  ? BANDS :
+                       (real_mode || half_spectrum)        ? (1 << size_sync[1]) / 2 + 1 : 1 << size_sync[1];
+
+    fft_in_flop #(N, width, real_mode, sample_bits, sample_coding) in_buf(
+        clk, sck, reset, sample_write, sample_index, sample, window_sync[1], size_sync[1],
+        in_busy, frame_pending, 1'b0, core_rd_data, core_load, core_start, core_rd_adr);
+
+    fft_format #(width, mag_cordic, accumulate, CORE_OUT, average_log2, smoothing, BANDS, N/2 + 1, sample_rate) formatter(
+        clk, reset, core_format, averaging_sync[1], core_out_start, core_done, core_exponent, core_wd_data,
+        frame_format, fmt_start, fmt_done, fmt_exponent, fmt_data);
+
+    fft_out_flop #(OUT_N, width, bfp) out_buf(clk, sck, reset, fmt_data, fmt_exponent, frame_format, fmt_start, fmt_done,
+                                              out_words, out_word, out_data, read_format, buf_ready);
+
+    // FFT Controller
+    generate
+        if (streaming) begin
+            fft_sdf #(N, width, cordic, LOAD_LATENCY) controller(
+                .clk(clk), .reset(reset),
+                .start(core_start), .load(core_load),
+                .load_address(core_rd_adr), .data_in(core_rd_data),
+                .done(core_done), .processing(core_processing),
+                .load_ready(core_load_ready), .out_start(core_out_start), .data_out(core_wd_data),
+                .exponent(core_exponent)
+            );
+        end else begin
+            fft_controller #(CORE_N, width, radix, pipe_depth, gauss, lanes, pairs, bfp, real_mode, cordic) controller(
+                .clk(clk), .reset(reset),
+                .start(core_start), .load(core_load), .inverse(inverse_sync[1]), .size(size_sync[1] - real_mode),
+                .load_address(core_rd_adr), .data_in(core_rd_data),
+                .done(core_done), .processing(core_processing),
+                .load_ready(core_load_ready), .out_start(core_out_start), .data_out(core_wd_data),
+                .exponent(core_exponent)
+            );
+        end
+    endgenerate
+
+endmodule
\ No newline at end of file
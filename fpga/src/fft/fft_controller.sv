@@ -0,0 +1,483 @@
+// fft_controller.sv - In-place N-point FFT core, M = log2(N) levels
+// radix = 2: M radix-2 levels x (N/2/P + 1 + D) clk cycles per frame
+// radix = 4: M/2 radix-2^2 passes x (N/2 + 2 + 2D), plus a radix-2 pass
+// x (N/2 + 1 + D) for the last level when M is odd
+// where D = pipe_depth, the butterfly latency, and P = lanes, the number of
+// radix-2 butterflies issued per cycle (the radix-2^2 engine runs one lane).
+// Each pass drains the pipeline before the next one reads its results.
+// With the default two memory pairs, loading and unloading overlap the
+// transform, so a frame takes max(N + 1, cycles/frame, N + 1) once streaming.
+//
+// Everything runs on the one clk edge. RAM and twiddle reads are registered,
+// so data and twiddles arrive one cycle after their addresses: the butterfly
+// phase, the write-back addresses and the drain's done are all delayed by
+// that cycle (the +1 per pass above). With cordic the twiddle ROM takes TL
+// cycles instead, so twiddles are looked up TL - 1 cycles ahead of their
+// reads from the counter's lookahead. Every bank has its own read and write
+// port, so no memory access has to share a cycle with another.
+//
+// Memory is two sides of 2P conflict-free banks (see bank_ram); every bank
+// does one read and one write per cycle, so there are no duplicate copies.
+// The table below is counted from the design, not taken from builds:
+// cycles from the schedule above, EBR as the 256x16 blocks (UP5K has 30)
+// the inferred memories need, DSP as the 16x16 SB_MAC16s (UP5K has 8) the
+// multipliers need. It has no LUT column because none of these
+// configurations has been through place and route; the crossbar column
+// (bank_ram's read and write muxes) is what grows with P in fabric.
+//
+//   (N = 512, width = 16; data EBR is per memory pair, the default two pairs
+//   double it, and data and twiddle EBR scale with N)
+//   config          cycles/frame (D=2)   data EBR   twiddle EBR   DSP   crossbar
+//   radix 2, P = 1        2331               8            2          4      2x2
+//   radix 2, P = 2        1179              16            4          8      4x4
+//   radix 2, P = 4         603              32            8         16      8x8
+//   radix 4, P = 1        1307               8            2          8      2x2
+//   (before banking: 4 x 512x32 copies = 16 data EBR, 2304 cycles)
+//
+// bfp = 1 enables block floating point. Every word written back (and every
+// word loaded) is checked for headroom; the next pass then halves its
+// butterfly inputs once per level if needed: a radix-2 pass shifts when any
+// part reaches FS/4 (full scale / 4), a radix-2^2 pass shifts once from FS/8
+// and twice from FS/4. This keeps every pass's output magnitude below
+// FS/sqrt(2), so nothing wraps as long as the loaded samples are below that.
+// The number of shifts is the frame's exponent: true result = data_out * 2^exponent.
+//
+// real_input = 1 treats the N complex words as 2N real samples,
+// {x[2n], x[2n+1]}, and the drain runs a split stage instead of reading
+// the result out: with Z = the N-point FFT of those words,
+//   X[k] = (Z[k] + Z*[N-k])/2 + W_2N^k * (Z[k] - Z*[N-k])/(2j),  k = 0..N
+// so data_out gives bins 0..N of the 2N-point real spectrum (the rest is
+// their conjugate). Each bin takes two reads, so the drain is 2N + 2 + TL + D
+// cycles against N for a complex frame, while the transform itself only
+// has N points. With bfp the split halves its result (exponent + 1).
+//
+// inverse = 1 while a frame loads makes that frame an inverse FFT on the
+// same hardware and schedule: re and im are swapped on load and again on
+// the drain (IFFT(X) = swap(FFT(swap(X)))), and every pass takes its full
+// shift whatever the range (one per level), which is the 1/N scaling, so
+// data_out is the inverse transform itself and exponent is 0. Complex frames
+// only: with real_input the flag is ignored (the split stage is forward-only).
+//
+// size, also taken with a frame's first load word, is log2 of that frame's
+// transform, up to M: N stays the largest size, and a smaller frame runs on
+// the low size address bits with the pass count, pass lengths, twiddle
+// stride (N / 2^size), load side and drain length all following it, so it
+// finishes proportionally sooner. Sizes below N need lanes = 1 (the bank
+// mapping is only conflict-free across all M address bits).
+
+module fft_controller #(parameter N=512, width=16, radix=4, pipe_depth=2, gauss=0, lanes=1, pairs=2, bfp=0,
+                                  real_input=0, cordic=0)
+                      (input logic                    clk, reset, start, load,
+                       input logic                    inverse,    // with load: this frame is an IFFT
+                       input logic [3:0]              size,       // with load: log2 of this frame's size
+                       input logic [$clog2(N)-1:0]    load_address,
+                       input logic [2*width-1:0]      data_in,
+                       output logic                   done,       // data_out holds a result word
+                       output logic                   processing, // a transform is running
+                       output logic                   load_ready, // a memory pair is free to load
+                       output logic                   out_start,  // a result is about to come out
+                       output logic [2*width-1:0]     data_out,
+                       output logic [3:0]             exponent);  // block exponent of data_out
+
+    localparam M = $clog2(N);
+    // the radix-2^2 engine only has a single-lane schedule
+    localparam P = (radix == 4) ? 1 : lanes;
+    // twiddle_rom's latency
+    localparam TL = cordic ? 1 + (cordic - 1) / 2 : 1;
+
+    // passes over memory for a size; the load goes to whichever side makes
+    // the last one end on side 1
+    function automatic logic load_side_of(input logic [3:0] levels);
+        return ((radix == 4) ? (levels + 1) / 2 : levels) % 2 == 0;
+    endfunction
+
+    logic                 issue_write, r4_level, level_done, compute_start, read_side, data_phase;
+    // M-bit address wires
+    logic [M-1:0]         fft_level, butterfly_iter, load_address_rev, out_address;
+    // the count TL - 1 cycles on, where the twiddles are looked up
+    logic [M-1:0]         ahead_level, ahead_iter;
+    logic                 ahead_r4;
+    logic [3:0]           fft_pass;
+    logic                 pass_end, draining;
+    logic [M+1:0]         out_count, data_count, drain_last;
+    logic [2*width-1:0]   drain_data;
+
+    // Ping-pong frame buffering: each pair of memory sides holds one frame.
+    // A frame is loaded into one side of a pair, transformed in place across
+    // both sides (ending on side 1) and drained from side 1. With two pairs
+    // frame N+1 loads while frame N computes and frame N-1 drains, so the
+    // frame rate is set by the slowest of the three; pairs = 1 serializes
+    // them (load may still overlap the drain).
+    logic [pairs-1:0]     full_in, full_out;
+    logic                 load_pair, compute_pair, drain_pair;
+
+    // one a/b leg pair per lane: [2*i] = a, [2*i+1] = b
+    logic [2*P-1:0][M-1:0]        read_address, write_address;
+    logic [2*P-1:0][2*width-1:0]  read_data, write_data;
+    logic [2*P-1:0]               proc_write;
+    logic [P-1:0][M-2:0]          twiddle_address, rom_address;
+    logic [P-1:0][2*width-1:0]    twiddle;
+    logic [pairs-1:0][2*P-1:0][2*width-1:0] pair_data;
+    logic [pairs-1:0][2*width-1:0] pair_out;
+
+    // block floating point: {>= FS/4, >= FS/8} seen in a frame's load or a pass's writes
+    logic [pairs-1:0][1:0] load_range;
+    logic [1:0]           pass_range, write_range, next_range, start_shift, next_shift, pass_shift;
+    logic                 next_r4, last_pass;
+    logic [3:0]           frame_exponent;
+    logic [pairs-1:0][3:0] pair_exponent;
+
+    // inverse frames and sizes: per pair as loaded, and as computed (for the drain)
+    logic [pairs-1:0]     in_inverse, out_inverse;
+    logic                 load_inverse, frame_inverse;
+    logic [pairs-1:0][3:0] in_size, out_size;
+    logic [3:0]           load_size, frame_size;
+    logic [M:0]           drain_n;
+    logic [2*width-1:0]   load_word;
+
+    function automatic logic [1:0] range_of(input logic [2*width-1:0] word);
+        logic [3:0] re_top, im_top;
+        re_top = word[2*width-1:2*width-4];
+        im_top = word[width-1:width-4];
+        range_of[1] = !(re_top[3:1] == 3'b000 || re_top[3:1] == 3'b111) ||
+                      !(im_top[3:1] == 3'b000 || im_top[3:1] == 3'b111);
+        range_of[0] = !(re_top == 4'b0000 || re_top == 4'b1111) ||
+                      !(im_top == 4'b0000 || im_top == 4'b1111);
+    endfunction
+
+    // shifts for the coming pass: one per level that could otherwise overflow,
+    // or every level when full
+    function automatic logic [1:0] shift_for(input logic [1:0] range, input logic r4, input logic full);
+        if (full)      return r4 ? 2 : 1;
+        else if (!bfp) return 0;
+        else if (r4)   return range[1] ? 2 : range[0];
+        else           return range[1];
+    endfunction
+
+    // a transform starts once its pair is loaded and the pair's last result is out
+    assign compute_start = !processing && full_in[compute_pair] && !full_out[compute_pair];
+    assign level_done = (fft_level == frame_size); // Done after size levels
+
+    // with an even number of passes the load side is the drain side, so a
+    // pair also has to be drained before it takes the next frame
+    assign load_ready = !full_in[load_pair] && !(load_side_of(size) && full_out[load_pair]);
+    assign out_start = full_out[drain_pair] && !draining;
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            processing <= 0;
+            draining <= 0;
+            full_in <= 0;
+            full_out <= 0;
+            load_pair <= 0;
+            compute_pair <= 0;
+            drain_pair <= 0;
+            load_range <= 0;
+            in_inverse <= 0;
+            out_inverse <= 0;
+            in_size <= {pairs{4'(M)}};
+            out_size <= {pairs{4'(M)}};
+        end else begin
+            if (load) load_range[load_pair] <= load_range[load_pair] | range_of(data_in);
+            if (load && load_address == 0) begin
+                in_inverse[load_pair] <= inverse && !real_input;
+                in_size[load_pair] <= size;
+            end
+
+            // 'start' pulses after a load
+            if (start) begin
+                full_in[load_pair] <= 1;
+                load_pair <= load_pair ^ (pairs == 2);
+            end
+
+            if (compute_start) begin
+                processing <= 1;
+            end else if (processing && level_done) begin
+                processing <= 0;
+                load_range[compute_pair] <= 0;
+                full_in[compute_pair] <= 0;
+                full_out[compute_pair] <= 1;
+                out_inverse[compute_pair] <= frame_inverse;
+                out_size[compute_pair] <= frame_size;
+                compute_pair <= compute_pair ^ (pairs == 2);
+            end
+
+            if (out_start) begin
+                draining <= 1;
+            end else if (draining && out_count == drain_last) begin
+                draining <= 0;
+                full_out[drain_pair] <= 0;
+                drain_pair <= drain_pair ^ (pairs == 2);
+            end
+        end
+    end
+
+    fft_counter #(N, radix, pipe_depth, P, TL - 1) counter(clk, processing, reset | compute_start, level_done,
+                                                           frame_size, fft_level, butterfly_iter, fft_pass, pass_end,
+                                                           ahead_level, ahead_iter);
+
+    // radix-2^2 passes cover levels (l, l+1); with an odd size the last level is radix-2
+    assign r4_level  = (radix == 4) && (fft_level + 1 < frame_size);
+    assign next_r4   = (radix == 4) && (fft_level + (r4_level ? 3 : 2) < frame_size);
+    assign last_pass = (fft_level + (r4_level ? 2 : 1) >= frame_size);
+    assign ahead_r4  = (radix == 4) && (ahead_level + 1 < frame_size);
+
+    // Block floating point: the range of everything a pass writes sets the
+    // next pass's shift; the first pass goes by the loaded samples
+    always_comb begin
+        write_range = 0;
+        for (int k = 0; k < 2*P; k++)
+            if (proc_write[k]) write_range = write_range | range_of(write_data[k]);
+    end
+
+    assign next_range  = pass_range | write_range;
+    assign start_shift = shift_for(load_range[compute_pair], radix == 4 && in_size[compute_pair] > 1,
+                                   in_inverse[compute_pair]);
+    assign next_shift  = shift_for(next_range, next_r4, frame_inverse);
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            pass_range <= 0;
+            pass_shift <= 0;
+            frame_exponent <= 0;
+            pair_exponent <= 0;
+            frame_inverse <= 0;
+            frame_size <= M;
+        end else if (compute_start) begin
+            frame_inverse <= in_inverse[compute_pair];
+            frame_size <= in_size[compute_pair];
+            pass_range <= 0;
+            pass_shift <= start_shift;
+            frame_exponent <= start_shift;
+        end else if (processing && level_done) begin
+            // an inverse frame's size shifts are the 1/N
+            pair_exponent[compute_pair] <= frame_inverse ? 4'd0 : frame_exponent;
+        end else if (pass_end && !last_pass) begin
+            pass_range <= 0;
+            pass_shift <= next_shift;
+            frame_exponent <= frame_exponent + next_shift;
+        end else if (processing) begin
+            pass_range <= next_range;
+        end
+    end
+
+    assign exponent = pair_exponent[drain_pair] + (real_input && bfp);
+
+    // output logic
+    assign drain_data = pair_out[drain_pair];
+
+    // the drained frame's points, and its last drain cycle: n reads, or two
+    // per real bin plus the split latency, then one more for the registered read
+    assign drain_n    = 1 << out_size[drain_pair];
+    assign drain_last = real_input ? 2*drain_n + 1 + TL + pipe_depth : drain_n;
+
+    // output counter for address; data_count is the read now on drain_data
+    always_ff @(posedge clk) begin
+        if (reset || !draining) out_count <= 0;
+        else                    out_count <= out_count + 1'b1;
+    end
+
+    always_ff @(posedge clk)
+        data_count <= out_count;
+
+    generate
+        if (real_input) begin : split
+            logic [M:0]             read_bin, bin;
+            logic [2*width-1:0]     z_k, a_half, b_half, x_even, x_odd, rom_twiddle, split_twiddle, unused;
+            logic [2*width-1:0]     x_even_q, x_odd_q;
+            logic                   last_bin;
+            logic signed [width-1:0] diff_re, diff_im;
+
+            // even cycles read Z[k], odd cycles Z[n-k] (Z[0] again for k = 0 and k = n),
+            // modulo n: below the full size, n itself is outside the frame
+            assign read_bin = out_count[M+1:1];
+            assign out_address = (out_count[0] ? drain_n - read_bin : read_bin) & (drain_n - 1'b1);
+
+            // one cycle later: Z[k] is on drain_data on even data_count, Z[N-k] on odd
+            assign bin = data_count[M+1:1];
+
+            always_ff @(posedge clk)
+                if (!data_count[0]) z_k <= drain_data;
+
+            // halve before adding so the sums cannot wrap; b is conj(Z[N-k])
+            assign a_half = {$signed(z_k[2*width-1:width]) >>> 1, $signed(z_k[width-1:0]) >>> 1};
+            assign b_half = {$signed(drain_data[2*width-1:width]) >>> 1, -($signed(drain_data[width-1:0]) >>> 1)};
+
+            assign x_even  = {a_half[2*width-1:width] + b_half[2*width-1:width], a_half[width-1:0] + b_half[width-1:0]};
+            assign diff_re = a_half[2*width-1:width] - b_half[2*width-1:width];
+            assign diff_im = a_half[width-1:0] - b_half[width-1:0];
+            assign x_odd   = {diff_im, -diff_re}; // -j * (a - b)
+
+            // W_2n^k = W_2N^(k N/n), looked up on the even cycle; W_2n^n = -W_2n^0.
+            // x_even and x_odd wait the rest of the twiddle latency.
+            twiddle_rom #(2*N, width, 1, cordic) split_rom(clk, bin[M-1:0] << (M - out_size[drain_pair]), rom_twiddle);
+            delay #(4*width+1, TL-1) split_align(clk, {x_even, x_odd, bin == drain_n},
+                                                 {x_even_q, x_odd_q, last_bin});
+            assign split_twiddle = last_bin ? {-rom_twiddle[2*width-1:width], -rom_twiddle[width-1:0]}
+                                            : rom_twiddle;
+
+            // X[k] = x_even + W * x_odd, the a output of a butterfly
+            butterfly_pipe #(width, pipe_depth, gauss) split_butterfly(clk, bfp != 0, x_even_q, x_odd_q, split_twiddle,
+                                                                       data_out, unused);
+            delay #(1, pipe_depth + TL - 1) split_valid(clk, draining && data_count[0] && bin <= drain_n, done);
+        end else begin
+            assign out_address = out_count[M-1:0];
+            assign data_out = out_inverse[drain_pair] ? {drain_data[width-1:0], drain_data[2*width-1:width]}
+                                                      : drain_data;
+
+            always_ff @(posedge clk)
+                done <= draining && out_count < drain_n;
+        end
+    endgenerate
+
+    agu #(N, P) address_generator(load_size, frame_size, fft_level, butterfly_iter, ahead_level, ahead_iter,
+                                  load_address, read_address, load_address_rev, twiddle_address);
+
+    // cycles that produce a write: all reads of a radix-2 level; on radix-2^2
+    // levels nothing is deferred yet on cycle 0 and cycle n/2 flushes the last group
+    assign issue_write = processing & (r4_level ? (butterfly_iter != 0 && butterfly_iter <= (1 << (frame_size-1)))
+                                                : (butterfly_iter < (1 << (frame_size-1))/P));
+
+    assign read_data = pair_data[compute_pair];
+
+    // pass 0 reads the load side, then the sides swap every pass
+    assign read_side = load_side_of(frame_size) ^ fft_pass[0];
+
+    // radix-2^2 phase of the pair now on read_data
+    always_ff @(posedge clk)
+        data_phase <= butterfly_iter[0];
+
+    // the first word of a load takes the flag before it is latched
+    assign load_inverse = (load_address == 0) ? inverse && !real_input : in_inverse[load_pair];
+    assign load_size    = (load_address == 0) ? size : in_size[load_pair];
+    assign load_word    = load_inverse ? {data_in[width-1:0], data_in[2*width-1:width]} : data_in;
+
+    genvar i, p, s;
+    generate
+        for (i = 0; i < P; i++) begin : lane
+            // write-back addresses delayed by the butterfly latency
+            write_agu #(N, pipe_depth) write_generator(clk, r4_level, butterfly_iter[0], issue_write,
+                                                    read_address[2*i], read_address[2*i+1],
+                                                    proc_write[2*i], write_address[2*i], write_address[2*i+1]);
+            assign proc_write[2*i+1] = proc_write[2*i];
+
+            // get our twiddle factors: W_n^k = W_N^(k N/n), looked up TL - 1
+            // cycles ahead; odd radix-2^2 cycles take w2 at half the index
+            assign rom_address[i] = (ahead_r4 && ahead_iter[0]) ? twiddle_address[i] >> 1 : twiddle_address[i];
+            twiddle_rom #(N, width, 1, cordic) twiddle_gen(clk, rom_address[i] << (M - frame_size), twiddle[i]);
+
+            // perform the operation
+            if (radix == 4) begin
+                butterfly_r22 #(width, pipe_depth, gauss) butt(clk, r4_level, data_phase,
+                                                               pass_shift != 0, pass_shift == 2,
+                                                               read_data[2*i], read_data[2*i+1], twiddle[i],
+                                                               write_data[2*i], write_data[2*i+1]);
+            end else begin
+                butterfly_pipe #(width, pipe_depth, gauss) butt(clk, pass_shift[0],
+                                                                read_data[2*i], read_data[2*i+1], twiddle[i],
+                                                                write_data[2*i], write_data[2*i+1]);
+            end
+        end
+
+        for (p = 0; p < pairs; p++) begin : pair
+            logic                                 computing, loading, unloading;
+            logic [1:0][2*P-1:0]                  side_write;
+            logic [1:0][2*P-1:0][M-1:0]           side_write_address, side_read_address;
+            logic [1:0][2*P-1:0][2*width-1:0]     side_write_data, side_read_data;
+
+            assign computing = (compute_pair == p) && processing;
+            assign loading   = (load_pair == p) && load;
+            assign unloading = (drain_pair == p) && draining;
+
+            always_comb begin
+                for (int k = 0; k < 2; k++) begin
+                    side_write[k]         = (computing && k != read_side) ? proc_write : '0;
+                    side_write_address[k] = write_address;
+                    side_write_data[k]    = write_data;
+                    side_read_address[k]  = read_address;
+                end
+
+                // the load side takes the load on leg 0
+                if (loading) begin
+                    side_write[load_side_of(load_size)]            = 1;
+                    side_write_address[load_side_of(load_size)][0] = load_address_rev;
+                    side_write_data[load_side_of(load_size)][0]    = load_word;
+                end
+
+                // leg 0 of side 1 reads out the result
+                if (unloading) side_read_address[1][0] = out_address;
+            end
+
+            for (s = 0; s < 2; s++) begin : side
+                bank_ram #(N, width, P) mem(clk, side_write[s], side_write_address[s], side_read_address[s],
+                                            side_write_data[s], side_read_data[s]);
+            end
+
+            // read from correct side for butterfly input (sides swap every pass)
+            assign pair_data[p] = side_read_data[read_side];
+            assign pair_out[p] = side_read_data[1][0];
+        end
+    endgenerate
+
+endmodule
+
+// Counts the level (log(N)), the butterfly index (N/2) and the memory pass.
+// With radix 4 each radix-2^2 pass covers two levels and runs one extra
+// cycle to flush the deferred half of its final group.
+// Every pass also runs on until the pipelined butterfly has drained.
+// With lanes > 1 a radix-2 level takes N/2/lanes cycles.
+// ahead_level/ahead_iter are where the count will be ahead cycles on (less
+// than a pass), for lookups with that much latency. Idle, or once that is
+// past the last level, they are level 0, whose twiddles are all W^0.
+module fft_counter #(parameter N=512, radix=2, pipe_depth=0, lanes=1, ahead=0)
+                   (input logic clk, processing, reset, done,
+                    input logic [3:0] size, // log2 of the frame's points
+                    output logic [$clog2(N)-1:0] fft_level, butterfly_iter,
+                    output logic [3:0] fft_pass,
+                    output logic pass_end, // last cycle of a pass
+                    output logic [$clog2(N)-1:0] ahead_level, ahead_iter);
+
+    localparam M = $clog2(N);
+
+    logic r4_level;
+    logic [M-1:0] last_iter, half, next_level;
+
+    assign half       = 1 << (size - 1);
+    assign r4_level   = (radix == 4) && (fft_level + 1 < size);
+    assign last_iter  = r4_level ? half + 1 + 2*pipe_depth : half/lanes + pipe_depth;
+    assign pass_end   = processing & ~done & (butterfly_iter == last_iter);
+    assign next_level = r4_level ? fft_level + 2'd2 : fft_level + 1'd1;
+
+    always_comb begin
+        ahead_level = fft_level;
+        ahead_iter  = butterfly_iter + ahead;
+        if (ahead != 0) begin
+            if (!processing || done) begin
+                ahead_level = 0;
+                ahead_iter  = 0;
+            end else if (butterfly_iter + ahead > last_iter) begin
+                ahead_level = (next_level < size) ? next_level : 0;
+                ahead_iter  = butterfly_iter + ahead - last_iter - 1;
+            end
+        end
+    end
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            fft_level <= 0;
+            butterfly_iter <= 0;
+            fft_pass <= 0;
+        end else if(processing == 1 & ~done) begin
+            // Count to n/2/lanes - 1, or n/2 for a radix-2^2 pass, plus the drain
+            if(butterfly_iter < last_iter) begin
+                butterfly_iter <= butterfly_iter + 1'd1;
+            end else begin
+                butterfly_iter <= 0;
+                fft_pass <= fft_pass + 1'd1;
+                // Count to size Levels
+                if (fft_level != size) fft_level <= r4_level ? fft_level + 2'd2 : fft_level + 1'd1;
+            end
+        end
+    end
+
+endmodule
@@ -0,0 +1,170 @@
+// fft_sdf.sv - Streaming N-point FFT (radix-2 single-path delay feedback)
+
+// Alternative to fft_controller with the same ports, less inverse (forward
+// transforms only). Takes one sample per clk cycle while load is high and
+// emits one bin per cycle (done high, data_out) in natural order, so frames
+// can follow each other back to back.
+//
+// M = log2(N) sdf_stage's in a row, stage s with N/2 >> s words of delay
+// feedback. Stage outputs are registered, so stage s sees sample n at local
+// index (n - s) mod (N >> s). The bit-reversed output of the last stage is put
+// in order by one RAM whose addressing alternates between natural and
+// bit-reversed every frame (read-before-write on the same address).
+//
+// Bin 0 of a frame comes out 2N + M cycles after its first sample (1033 for
+// N = 512): N - 1 + M through the stages, one frame in the reorder RAM and
+// one RAM read.
+// Back to back there is no gap between frames' bins, so out_start (the cycle
+// before a frame's first bin) comes with the previous frame's last done;
+// fft_format and fft_out_flop take both in the same cycle.
+// Frames start on N-cycle block boundaries. After the last frame the
+// pipeline runs on for three blocks to flush it out; 'processing' is high
+// while flushing except for load_latency cycles before each boundary
+// (load_ready), the cycles from a loader seeing load_ready to its first word
+// arriving, so a frame requested then lands on the boundary. Idle, load_ready
+// stays high and the block count waits for the first word. start and
+// load_address are not needed.
+// There is no block floating point here; exponent is always 0.
+module fft_sdf #(parameter N=512, width=16, cordic=0, load_latency=1)
+               (input logic                    clk, reset, start, load,
+                input logic [$clog2(N)-1:0]    load_address,
+                input logic [2*width-1:0]      data_in,
+                output logic                   done,
+                output logic                   processing,
+                output logic                   load_ready,
+                output logic                   out_start,
+                output logic [2*width-1:0]     data_out,
+                output logic [3:0]             exponent);
+
+    localparam M = $clog2(N);
+
+    logic               en, drain_active, loaded_block, frame_valid;
+    logic               reorder_parity, parity_next;
+    logic [1:0]         drain_blocks, loaded_hist;
+    logic [M-1:0]       n, n_next, m, m_rev, reorder_address;
+    logic [2*width-1:0] stage_data [M:0]; // [0] = input, [s+1] = output of stage s
+
+    // run while loading and until the last frame has come out
+    assign drain_active = (drain_blocks != 0);
+    assign en = load | drain_active;
+    assign n_next = en ? n + 1'b1 : n;
+    assign load_ready = !drain_active || (n == N - load_latency);
+    assign processing = !load_ready;
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            n <= 0;
+            drain_blocks <= 0;
+            loaded_block <= 0;
+            loaded_hist <= 0;
+            frame_valid <= 0;
+            reorder_parity <= 0;
+        end else if (en) begin
+            n <= n + 1'b1;
+
+            if (load) drain_blocks <= 3;
+            else if (n == N-1) drain_blocks <= drain_blocks - 1'b1;
+
+            // a block's bins start coming out at n = M two blocks later
+            if (n == N-1) begin
+                loaded_hist <= {loaded_hist[0], loaded_block | load};
+                loaded_block <= 0;
+            end else begin
+                loaded_block <= loaded_block | load;
+            end
+            if (n == M-1) frame_valid <= loaded_hist[1];
+
+            reorder_parity <= parity_next;
+        end
+    end
+
+    // Pipeline of delay-feedback stages
+    assign stage_data[0] = load ? data_in : '0;
+
+    genvar s;
+    generate
+        for (s = 0; s < M; s++) begin : stage
+            sdf_stage #(N, width, s, cordic) butterfly(clk, en, n, n_next, stage_data[s], stage_data[s+1]);
+        end
+    endgenerate
+
+    // Reorder: position m of the last stage's output is bin reverse(m)
+    assign m = n - (M-1);
+    reverse_bits #(M) reorder_logic(m, m_rev);
+
+    assign parity_next = (m == 0) ? ~reorder_parity : reorder_parity;
+    assign reorder_address = parity_next ? m_rev : m;
+
+    ram #(N, 2*width) reorder_mem(clk, en, reorder_address, reorder_address, stage_data[M], data_out);
+
+    assign done = frame_valid & en;
+    assign out_start = en && (n == M-1) && loaded_hist[1];
+    assign exponent = 0;
+
+endmodule
+
+
+// One radix-2 DIF delay-feedback stage with N/2 >> stage words of feedback.
+// First half of each block: the input fills the FIFO and the differences
+// fed back in the previous block come out multiplied by W^(k * 2^stage).
+// Second half: sums come out and the differences are fed back.
+module sdf_stage #(parameter N=512, width=16, stage=0, cordic=0)
+    (input logic                    clk, en,
+     input logic [$clog2(N)-1:0]    n, n_next,
+     input logic [2*width-1:0]      x,
+     output logic [2*width-1:0]     y);
+
+    localparam L = N/2 >> stage;
+    localparam kbits = $clog2(N) - stage; // log2(2L)
+    // twiddle_rom's latency
+    localparam TL = cordic ? 1 + (cordic - 1) / 2 : 1;
+
+    logic [kbits-1:0]       k, k_next, k_twiddle;
+    logic [$clog2(N)-2:0]   twiddle_address;
+    logic [2*width-1:0]     fifo_in, fifo_out, sum, diff, diff_tw, twiddle;
+
+    // local index within the block
+    assign k = n - stage;
+    assign k_next = n_next - stage;
+
+    // complex add/sub on packed {re, im}
+    assign sum  = {fifo_out[2*width-1:width] + x[2*width-1:width], fifo_out[width-1:0] + x[width-1:0]};
+    assign diff = {fifo_out[2*width-1:width] - x[2*width-1:width], fifo_out[width-1:0] - x[width-1:0]};
+
+    // the ROM takes TL cycles, so look up the index TL cycles on. After an
+    // idle gap the first TL - 1 lookups are stale, but they only multiply the
+    // flushed (zero) FIFO
+    assign k_twiddle = k_next + (TL - 1);
+    assign twiddle_address = (k_twiddle % L) << stage;
+    twiddle_rom #(N, width, 1, cordic) twiddle_gen(clk, twiddle_address, twiddle);
+
+    complex_mult #(width) twiddle_mult(fifo_out, twiddle, diff_tw);
+
+    assign fifo_in = (k < L) ? x : diff;
+
+    always_ff @(posedge clk)
+        if (en) y <= (k < L) ? diff_tw : sum;
+
+    // Delay feedback: EBR for the long stages, flip-flops for the short ones
+    generate
+        if (L >= 32) begin
+            logic [kbits-2:0] ptr, ptr_next;
+
+            assign ptr = k;
+            assign ptr_next = k_next;
+
+            ram #(L, 2*width) delay_mem(clk, en, ptr, ptr_next, fifo_in, fifo_out);
+        end else begin
+            logic [2*width-1:0] shift [L-1:0];
+
+            always_ff @(posedge clk)
+                if (en) begin
+                    shift[0] <= fifo_in;
+                    for (int i = 1; i < L; i++) shift[i] <= shift[i-1];
+                end
+
+            assign fifo_out = shift[L-1];
+        end
+    endgenerate
+
+endmodule
@@ -0,0 +1,126 @@
+// Streaming core testbench: three 64-point frames of the square wave go
+// through fft_sdf back to back. Like fft_in_flop, each frame is requested
+// when load_ready is seen and its first word arrives LATENCY cycles later,
+// so the frames only line up with the blocks if load_ready comes early
+// enough. Every frame is checked against the same reference, and goes
+// through an fft_out_flop that has to report each one ready: out_start
+// comes with the last bin of the frame before, and only then.
+module fft_sdf_testbench();
+
+   localparam N = 64;
+   localparam FRAMES = 3;
+   localparam LATENCY = 3;
+
+   logic clk;
+   logic start, load, done, reset, processing, load_ready, out_start;
+   logic [3:0]         exponent;
+   logic signed [15:0] expected_re, expected_im, wd_re, wd_im;
+   logic [31:0]        rd, wd;
+   logic [31:0]        out_idx, expected;
+
+   logic [31:0]          input_data [0:N-1];
+   logic [31:0]        expected_out [0:N-1];
+
+   // frame requests: cycle, first word of each frame and where the input is free
+   integer             cycle, requested, free_at, frame;
+   integer             frame_start [0:FRAMES-1];
+   integer             errors, ready_count;
+   logic               out_start_seen, buf_ready, last_ready;
+   logic [31:0]        buf_data;
+   logic [2:0]         buf_format;
+
+   logic [5:0]            rd_adr;
+
+   fft_sdf #(.N(N), .load_latency(LATENCY)) dut(clk, reset, start, load, rd_adr, rd,
+                                                done, processing, load_ready, out_start, wd, exponent);
+
+   // the output buffer as the top uses it, not read (out_word resting at all ones)
+   fft_out_flop #(N, 16, 0) out_buf(clk, 1'b0, reset, wd, exponent, 3'd0, out_start, done, 7'(N), '1,
+                                    buf_data, buf_format, buf_ready);
+
+   // clk
+   always
+     begin
+	    clk = 1; #5; clk=0; #5;
+     end
+
+   initial
+     begin
+	$readmemh("simulation/test_in_square.memh", input_data);
+	$readmemh("simulation/ideal_test_out_square.memh", expected_out);
+	cycle = 0; requested = 0; free_at = 0; errors = 0; ready_count = 0;
+	reset=1; #40; reset=0;
+     end
+
+   // ask for the next frame when load_ready is seen, unless it would
+   // arrive before the previous one is in; each one after the first
+   // should land right behind the one before
+   always @(posedge clk)
+     if (~reset) begin
+	cycle <= cycle + 1;
+	if (load_ready && requested < FRAMES && cycle + LATENCY >= free_at) begin
+	   if (requested > 0 && cycle + LATENCY != free_at)
+	     $display("Frame %0d is not back to back with frame %0d", requested, requested - 1);
+	   frame_start[requested] <= cycle + LATENCY;
+	   free_at <= cycle + LATENCY + N;
+	   requested <= requested + 1;
+	end
+     end
+
+   // the frame being loaded this cycle, if any
+   always_comb begin
+      frame = -1;
+      for (int i = 0; i < FRAMES; i++)
+	if (i < requested && cycle >= frame_start[i] && cycle < frame_start[i] + N) frame = i;
+   end
+
+   assign load = (frame >= 0);
+   assign start = 0;
+   assign rd_adr = load ? cycle - frame_start[frame] : 0;
+   assign rd = load ? input_data[rd_adr] : 0;
+
+   // bins come out in natural order, out_start ahead of each frame's first
+   always @(posedge clk)
+     if (reset) out_idx <= 0;
+     else if (done) out_idx <= out_idx + 1;
+
+   assign expected = expected_out[out_idx % N];
+   assign expected_re = expected[31:16];   // get real      part of `expected` (gt output)
+   assign expected_im = expected[15:0];         // get imaginary part of `expected` (gt output)
+   assign wd_re = wd[31:16];               // get real      part of `wd` (computed output)
+   assign wd_im = wd[15:0];                     // get imaginary part of `wd` (computed output)
+
+   // compare within +/- 5 (the stages round every twiddle product)
+   always @(posedge clk)
+     if (done && out_idx < FRAMES * N) begin
+	if ((out_idx % N == 0) && !out_start_seen)
+	   $display("Frame %0d: no out_start before bin 0", out_idx / N);
+	if (out_start && (out_idx % N != N - 1))
+	   $display("Frame %0d: out_start with bin %0d", out_idx / N, out_idx % N);
+	if ((wd_re > expected_re + 5) || (wd_re < expected_re - 5) ||
+            (wd_im > expected_im + 5) || (wd_im < expected_im - 5)) begin
+	   errors = errors + 1;
+	   $display("Error @ frame %0d bin %0d: expected %d+j%d, got %d+j%d",
+                    out_idx / N, out_idx % N, expected_re, expected_im, wd_re, wd_im);
+	end
+     end else if (out_idx == FRAMES * N) begin
+	// the last frame's edge is on this cycle
+	if (ready_count + (buf_ready && !last_ready) != FRAMES)
+	   $display("Output buffer reported %0d of %0d frames ready",
+		    ready_count + (buf_ready && !last_ready), FRAMES);
+	$display("SDF test complete: %0d frames, %0d errors.", FRAMES, errors);
+        $stop;
+     end
+
+   // one buf_ready edge per frame, as the top counts them
+   always @(posedge clk) begin
+      last_ready <= buf_ready;
+      if (buf_ready && !last_ready) ready_count <= ready_count + 1;
+   end
+
+   // out_start comes the cycle before each frame's first bin
+   always @(posedge clk)
+     if (reset) out_start_seen <= 0;
+     else if (out_start) out_start_seen <= 1;
+     else if (done) out_start_seen <= 0;
+endmodule // fft_sdf_testbench
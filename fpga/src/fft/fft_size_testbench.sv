@@ -0,0 +1,30 @@
+// Runtime size testbench: the square-wave vectors through cores run below
+// their full size, which must give what the full-size builds give:
+//   complex: a 512-point core at size 6, exactly as fft_testbench_64
+//   real:    a 64-word real-input core at size 5, as fft_real_testbench
+module fft_size_testbench();
+
+   logic clk, reset;
+   logic [1:0] finished;
+
+   fft_vector_check #(.N(512), .size(6), .out_file("test_out_size.memh")) complex_512(clk, reset, finished[0]);
+   fft_vector_check #(.N(64), .size(5), .real_input(1), .tolerance(5), .out_file("test_out_size_real.memh"))
+      real_64(clk, reset, finished[1]);
+
+   // clk
+   always
+     begin
+	    clk = 1; #5; clk=0; #5;
+     end
+
+   initial
+     begin
+	reset=1; #40; reset=0;
+     end
+
+   always @(posedge clk)
+     if (&finished) begin
+	$display("Reduced size tests complete.");
+        $stop;
+     end
+endmodule // fft_size_testbench
@@ -0,0 +1,134 @@
+`timescale 1ns/1ps
+
+module fft_testbench();
+
+    // --- 1. Simulation Parameters ---
+    localparam POINTS = 512;          // N
+    localparam M = $clog2(POINTS);    // 9 levels
+    localparam WIDTH = 16;            // 16-bit precision
+
+    // --- 2. Signals ---
+    logic clk;      // Core clock (logic, RAM and ROM)
+    logic reset;
+    logic start, load, done, processing, load_ready, out_start;
+    logic [3:0] exponent;
+    
+    // Data Signals
+    logic [M-1:0]       rd_adr;
+    logic [2*WIDTH-1:0] rd;        // Input to FFT (32-bit)
+    logic [2*WIDTH-1:0] wd;        // Output from FFT (32-bit)
+    
+    // Testbench Variables
+    integer             idx_counter; 
+    integer             out_idx;     
+    integer             f;           
+    
+    // Memory Arrays
+    logic [7:0]         input_data_8bit [0:POINTS-1]; 
+    logic [31:0]        expected_out [0:POINTS-1];
+    logic [31:0]        expected_val;
+
+    // Comparison Variables
+    logic signed [15:0] exp_re, exp_im, got_re, got_im;
+
+    // --- 3. DUT Instantiation ---
+    // Connects to the in-place FFT core
+    fft_controller #(.N(POINTS), .width(WIDTH)) dut (
+        .clk(clk),
+        .reset(reset),
+        .start(start),
+        .load(load),
+        .inverse(1'b0),
+        .size(4'($clog2(POINTS))),
+        .load_address(rd_adr),
+        .data_in(rd),
+        .done(done),
+        .processing(processing),
+        .load_ready(load_ready),
+        .out_start(out_start),
+        .data_out(wd),
+        .exponent(exponent)
+    );
+
+    // --- 4. Clock Generation ---
+    // 10ns period = 100 MHz; the whole core runs on this one clock
+    initial clk = 0;
+    always #5 clk = ~clk; 
+
+    // --- 5. Setup & File Loading ---
+    initial begin
+        // Ensure files are in the simulation directory!
+        // Note: Filenames match what your Python script generated
+        $readmemh("test_in.memh", input_data_8bit);
+        $readmemh("test_out.memh", expected_out);
+        
+        f = $fopen("simulation_results.txt", "w");
+
+        // Initialize signals
+        idx_counter = 0; 
+        out_idx = 0;
+        reset = 1; 
+        
+        // Hold reset for 200ns to clear all RAMs/Counters
+        #200;       
+        reset = 0; 
+    end
+
+    // --- 6. The Driver Logic (Runs on the core clock) ---
+    // We drive inputs on the same clock domain the logic uses.
+    always @(posedge clk) begin
+        if (reset) begin
+            idx_counter <= 0;
+        end else begin
+            // Stop incrementing when we reach POINTS (Start Pulse)
+            if (idx_counter <= POINTS) begin
+                idx_counter <= idx_counter + 1;
+            end
+        end
+    end
+
+    // Signals
+    assign load  = (idx_counter < POINTS);   // High for 0 to POINTS-1
+    assign start = (idx_counter == POINTS);  // Pulse High at POINTS
+
+    assign rd_adr = idx_counter[M-1:0];
+    
+    // Padding logic: {8'b0, data, 16'b0}, as in the Extend module
+    // (the sample is the real part)
+    // Ternary operator prevents driving X during idle states
+    assign rd = (idx_counter < POINTS) ? 
+                {8'b0, input_data_8bit[idx_counter[M-1:0]], 16'b0} : 
+                32'h0;
+
+
+    // --- 7. Verification Logic (Runs on the core clock) ---
+    // done is only high while results drain, so the end is checked on its own
+    always @(posedge clk) begin
+        if (done && !reset && out_idx < POINTS) begin
+            expected_val = expected_out[out_idx];
+            exp_re = expected_val[31:16];
+            exp_im = expected_val[15:0];
+            
+            got_re = wd[31:16];
+            got_im = wd[15:0];
+
+            $fwrite(f, "Idx %0d: Exp %d + j%d | Got %d + j%d\n", 
+                    out_idx, exp_re, exp_im, got_re, got_im);
+
+            // Check for mismatch (Tolerance +/- 5)
+            if ((got_re > exp_re + 5) || (got_re < exp_re - 5) ||
+                (got_im > exp_im + 5) || (got_im < exp_im - 5)) begin
+                
+                $display("ERROR @ Idx %0d: Exp %d+j%d, Got %d+j%d", 
+                         out_idx, exp_re, exp_im, got_re, got_im);
+            end 
+
+            out_idx <= out_idx + 1;
+        end else if (out_idx == POINTS) begin
+            $display("FFT Simulation Complete. Check simulation_results.txt");
+            $fclose(f);
+            $stop;
+        end
+    end
+
+endmodule
\ No newline at end of file
@@ -0,0 +1,106 @@
+// Testbench taken from https://github.com/AlecVercruysse/fft_tutorial and modified for a 64-point fft
+module fft_testbench_64();
+
+   logic clk, reset, finished;
+
+   // same core as the 512-point build, sized down to 64 points
+   fft_vector_check #(.N(64), .size(6)) check_64(clk, reset, finished);
+
+   // clk
+   always
+     begin
+	    clk = 1; #5; clk=0; #5;
+     end
+
+   initial
+     begin
+	reset=1; #40; reset=0;
+     end
+
+   always @(posedge clk)
+     if (finished) begin
+	$display("FFT test complete.");
+        $stop;
+     end
+endmodule // fft_testbench_64
+
+// Runs the square-wave vectors through an N-point fft_controller at a given
+// size and checks the result: 64 complex words at size 6, or with
+// real_input the 64 real samples as 32 words {x[2n], x[2n+1]} at size 5.
+// Both give the same 64-point spectrum, all 64 bins or bins 0..32 out of the
+// split stage. Words are compared exactly, or within +/- tolerance, and
+// written to out_file; finished rises once they are all out.
+module fft_vector_check #(parameter N=64, size=6, real_input=0, tolerance=0, out_file="test_out_square.memh")
+   (input logic clk, reset,
+    output logic finished);
+
+   localparam WORDS = 1 << size;                         // words loaded
+   localparam BINS  = real_input ? WORDS + 1 : WORDS;    // words checked
+
+   logic start, load, done, processing, load_ready, out_start;
+   logic [3:0]         exponent;
+   logic signed [15:0] expected_re, expected_im, wd_re, wd_im;
+   logic [31:0]        rd, wd;
+   logic [31:0]        idx, out_idx, expected;
+   logic               mismatch;
+
+   logic [$clog2(N)-1:0]  rd_adr;
+   assign rd_adr = idx[$clog2(N)-1:0];
+
+   logic [31:0]          input_data [0:63];
+   logic [31:0]        expected_out [0:63];
+
+   integer             f; // file pointer
+
+   fft_controller #(.N(N), .real_input(real_input)) dut(clk, reset, start, load, 1'b0, 4'(size), rd_adr, rd,
+                                                        done, processing, load_ready, out_start, wd, exponent);
+
+   // start of test: load `input_data`, `expected_out`, open output file.
+   initial
+     begin
+	$readmemh("simulation/test_in_square.memh", input_data);
+	$readmemh("simulation/ideal_test_out_square.memh", expected_out);
+        f = $fopen(out_file, "w"); // write computed values.
+	idx=0; finished=0;
+     end
+
+   // increment testbench counter and derive load/start signals
+   always @(posedge clk)
+     if (~reset) idx <= idx + 1;
+     else idx <= idx;
+   assign load =  idx < WORDS;
+   assign start = idx === WORDS;
+
+   // increment output address if done, reset if restarting FFT
+   always @(posedge clk)
+     if (load) out_idx <= 0;
+     else if (done) out_idx <= out_idx + 1;
+
+   // load/start logic: read in test data by addressing `input_data` with `idx`,
+   // two real parts per word with real_input
+   assign rd = !load     ? 0 :
+               real_input ? {input_data[2*idx][31:16], input_data[2*idx+1][31:16]} : input_data[idx[5:0]];
+   assign expected = expected_out[out_idx[5:0]]; // get test output by addressing `expected_out` with `idx`.
+   assign expected_re = expected[31:16];   // get real      part of `expected` (gt output)
+   assign expected_im = expected[15:0];         // get imaginary part of `expected` (gt output)
+   assign wd_re = wd[31:16];               // get real      part of `wd` (computed output)
+   assign wd_im = wd[15:0];                     // get imaginary part of `wd` (computed output)
+
+   assign mismatch = (tolerance == 0) ? (wd !== expected) :
+                     $isunknown(wd) || (wd_re > expected_re + tolerance) || (wd_re < expected_re - tolerance) ||
+                     (wd_im > expected_im + tolerance) || (wd_im < expected_im - tolerance);
+
+   // if FFT is done, compare gt to computed output, and write computed output to file.
+   // (done drops after the last word, so finish once all have been seen)
+   always @(posedge clk)
+     if (done && out_idx < BINS) begin
+        $fwrite(f, "%h\n", wd);
+	if (mismatch) begin
+	   $display("Error @ out_idx %d (N = %0d, size %0d): expected %b (got %b)    expected: %d+j%d, got %d+j%d",
+                    out_idx, N, size, expected, wd, expected_re, expected_im, wd_re, wd_im);
+	end
+     end else if (out_idx == BINS && !finished) begin
+        $fclose(f);
+        finished <= 1;
+     end
+endmodule // fft_vector_check
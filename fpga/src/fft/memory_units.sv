@@ -0,0 +1,350 @@
+// memory_units.sv - Memories for an N-point FFT
+
+// log2(words) address bits (N words for a full frame, fewer when used as a bank)
+module ram #(parameter words=512, data_width=32)
+           (input logic                      clk, write,
+            input logic [$clog2(words)-1:0]  write_address, read_address,
+            input logic [data_width-1:0]     d,
+            output logic [data_width-1:0]    q);
+
+    logic [data_width-1:0] mem [words-1:0];
+
+    always_ff @(posedge clk)
+        if (write) begin
+            mem[write_address] <= d;
+        end
+
+    always_ff @(posedge clk)
+        q <= mem[read_address];
+
+endmodule
+
+// ram with the write port on wclk and the read port on rclk (the EBR clocks
+// are independent), for buffers between the SPI clock and the core clock
+module ram_2clk #(parameter words=512, data_width=32)
+                (input logic                      wclk, rclk, write,
+                 input logic [$clog2(words)-1:0]  write_address, read_address,
+                 input logic [data_width-1:0]     d,
+                 output logic [data_width-1:0]    q);
+
+    logic [data_width-1:0] mem [words-1:0];
+
+    always_ff @(posedge wclk)
+        if (write) begin
+            mem[write_address] <= d;
+        end
+
+    always_ff @(posedge rclk)
+        q <= mem[read_address];
+
+endmodule
+
+// Conflict-free banked memory for 'lanes' butterflies per cycle: 2*lanes
+// banks of N/(2*lanes) words, one read and one write per bank per cycle.
+// Address bit i adds bank_vector(i) (XOR) to the bank number, chosen so any
+// cyclic run of log2(2*lanes) bit positions gives independent vectors. The
+// legs of one cycle's butterflies only differ in such a run at every level,
+// so they always land in different banks. Within a bank the offset is the
+// address without its low bank bits. Port 0 wins if ports do collide (the
+// single load/unload port while the other legs are idle).
+// Reads are registered like ram: q is the data for last cycle's read_address,
+// so the output crossbar uses the banks registered with it.
+module bank_ram #(parameter N=512, width=16, lanes=1)
+    (input logic                                clk,
+     input logic [2*lanes-1:0]                  write,
+     input logic [2*lanes-1:0][$clog2(N)-1:0]   write_address, read_address,
+     input logic [2*lanes-1:0][2*width-1:0]     d,
+     output logic [2*lanes-1:0][2*width-1:0]    q);
+
+    localparam M     = $clog2(N);
+    localparam banks = 2*lanes;
+    localparam bits  = $clog2(banks);
+
+    // bits = 2: 01 and 10 alternate, 11 closes an odd cycle
+    // bits = 3: unit vectors in turn, the last M % 3 positions close the cycle
+    function automatic logic [bits-1:0] bank_vector(input int i);
+        if (bits == 1)                return 1;
+        else if (bits == 2)           return (M % 2 == 1 && i == M-1) ? 3 : (i % 2 == 0) ? 1 : 2;
+        else if (i < M - M % 3)       return 1 << (i % 3);
+        else if (M % 3 == 1)          return 7;
+        else                          return (i == M-2) ? 3 : 5;
+    endfunction
+
+    function automatic logic [bits-1:0] bank_of(input logic [M-1:0] address);
+        bank_of = 0;
+        for (int i = 0; i < M; i++)
+            if (address[i]) bank_of = bank_of ^ bank_vector(i);
+    endfunction
+
+    logic [banks-1:0]                bank_write;
+    logic [banks-1:0][M-1-bits:0]    bank_write_address, bank_read_address;
+    logic [banks-1:0][2*width-1:0]   bank_d, bank_q;
+    logic [banks-1:0][bits-1:0]      read_bank;
+
+    always_comb begin
+        bank_write = '0;
+        bank_write_address = '0;
+        bank_read_address = '0;
+        bank_d = '0;
+        for (int p = banks-1; p >= 0; p--) begin
+            if (write[p]) begin
+                bank_write[bank_of(write_address[p])] = 1'b1;
+                bank_write_address[bank_of(write_address[p])] = write_address[p][M-1:bits];
+                bank_d[bank_of(write_address[p])] = d[p];
+            end
+            bank_read_address[bank_of(read_address[p])] = read_address[p][M-1:bits];
+        end
+        for (int p = 0; p < banks; p++)
+            q[p] = bank_q[read_bank[p]];
+    end
+
+    always_ff @(posedge clk)
+        for (int p = 0; p < banks; p++)
+            read_bank[p] <= bank_of(read_address[p]);
+
+    genvar k;
+    generate
+        for (k = 0; k < banks; k++) begin : bank
+            ram #(N/banks, 2*width) bank_mem(clk, bank_write[k], bank_write_address[k], bank_read_address[k],
+                                             bank_d[k], bank_q[k]);
+        end
+    endgenerate
+
+endmodule
+
+// Twiddle ROM - N/2 entries of W^n = e^(-2*pi*j*n/N), {re, im}.
+// The contents are computed at elaboration: each part is scaled by
+// 2^(width-1) - 1 and truncated, the same values rom/twiddle.py writes.
+//
+// compress = 1 only stores the first octant, N/8 + 1 {cos, sin} pairs
+// (65 instead of 256 words for N = 512). Within a quadrant, m > N/8 reads
+// entry N/4 - m with cos and sin swapped; the second quadrant is
+// -j * W^(n - N/4). Sign and swap are applied after the registered read, so
+// the latency is still one cycle, and since truncation is symmetric about
+// zero the result is bit-exact with the full table (twiddle_rom_testbench).
+//
+// cordic > 0 replaces the octant table with that many CORDIC rotations
+// (no EBR), pipelined two per clock with the output register taking the
+// last one or two, so the latency is 1 + (cordic - 1) / 2 cycles (8 for 16
+// iterations) instead of one. Callers issue addresses that many cycles
+// ahead of use. It is not bit-exact; measured against the table at N = 4096,
+// width = 16
+// (FFT output SNR for random full-band input, table alone 58.2 dB):
+//   iterations   twiddle SNR   max error   FFT output SNR
+//        8          47.0 dB     254 LSB        37.2 dB
+//       10          59.0 dB      63 LSB        49.9 dB
+//       12          70.9 dB      16 LSB        56.4 dB
+//       14          82.3 dB       5 LSB        58.1 dB
+//       16          88.7 dB       2 LSB        58.3 dB
+// twiddle_rom_testbench prints the twiddle SNR for a few settings.
+module twiddle_rom #(parameter N=512, width=16, compress=1, cordic=0)
+                   (input logic clk,
+                    input logic [$clog2(N)-2:0] twiddle_address,
+                    output logic [2*width-1:0] twiddle);
+
+    localparam M = $clog2(N);
+    localparam real pi    = 3.141592653589793;
+    localparam real scale = 2.0**(width-1) - 1;
+    // address to twiddle, in cycles
+    localparam LATENCY = cordic ? 1 + (cordic - 1) / 2 : 1;
+
+    function automatic logic [N*width-1:0] twiddle_table();
+        real angle;
+        logic signed [width-1:0] w_re, w_im;
+        for (int n = 0; n < N/2; n++) begin
+            angle = 2.0 * pi * n / N;
+            w_re = $rtoi($cos(angle) * scale);
+            w_im = $rtoi(-$sin(angle) * scale);
+            twiddle_table[2*width*n +: 2*width] = {w_re, w_im};
+        end
+    endfunction
+
+    function automatic logic [(N/8+1)*2*width-1:0] octant_table();
+        real angle;
+        logic signed [width-1:0] w_cos, w_sin;
+        for (int n = 0; n <= N/8; n++) begin
+            angle = 2.0 * pi * n / N;
+            w_cos = $rtoi($cos(angle) * scale);
+            w_sin = $rtoi($sin(angle) * scale);
+            octant_table[2*width*n +: 2*width] = {w_cos, w_sin};
+        end
+    endfunction
+
+    generate
+        if (compress || cordic) begin : folded
+            logic [M-3:0]            m, m_octant;
+            logic                    swap, swap_q, quadrant_q;
+            logic [2*width-1:0]      entry;
+            logic signed [width-1:0] w_cos, w_sin;
+
+            // position within the quadrant, folded into the first octant
+            assign m = twiddle_address[M-3:0];
+            assign swap = (m > N/8);
+            assign m_octant = swap ? N/4 - m : m;
+
+            delay #(2, LATENCY) fold_stage(clk, {swap, twiddle_address[M-2]}, {swap_q, quadrant_q});
+
+            if (cordic) begin : rotate
+                // G guard bits on x and y; angles in 1/2^Z turns
+                localparam G = 3;
+                localparam Z = width + 4;
+
+                function automatic logic signed [Z:0] atan_step(input int i);
+                    return $rtoi($atan(2.0**(-i)) / (2.0 * pi) * 2.0**Z + 0.5);
+                endfunction
+
+                // start at (1/K, 0) so the rotation gain K comes out as 1
+                function automatic logic signed [width+G:0] start_x();
+                    real k;
+                    k = 1.0;
+                    for (int i = 0; i < cordic; i++) k = k / $sqrt(1.0 + 2.0**(-2*i));
+                    return $rtoi(k * scale * 2.0**G + 0.5);
+                endfunction
+
+                logic signed [width+G:0] x [cordic:0];
+                logic signed [width+G:0] y [cordic:0];
+                logic signed [Z:0]       z [cordic:0];
+                logic signed [width+G:0] x_round, y_round;
+
+                assign x[0] = start_x();
+                assign y[0] = 0;
+                assign z[0] = m_octant << (Z - M);
+
+                // rotate towards z = 0 by +-atan(2^-i), registered after
+                // every second iteration except where entry takes over
+                genvar i;
+                for (i = 0; i < cordic; i++) begin : iteration
+                    logic                    up;
+                    logic signed [width+G:0] x_next, y_next;
+                    logic signed [Z:0]       z_next;
+
+                    assign up = (z[i] >= 0);
+                    assign x_next = up ? x[i] - (y[i] >>> i) : x[i] + (y[i] >>> i);
+                    assign y_next = up ? y[i] + (x[i] >>> i) : y[i] - (x[i] >>> i);
+                    assign z_next = up ? z[i] - atan_step(i) : z[i] + atan_step(i);
+
+                    if (i % 2 == 1 && i + 1 < cordic) begin : stage
+                        always_ff @(posedge clk) begin
+                            x[i+1] <= x_next;
+                            y[i+1] <= y_next;
+                            z[i+1] <= z_next;
+                        end
+                    end else begin
+                        assign x[i+1] = x_next;
+                        assign y[i+1] = y_next;
+                        assign z[i+1] = z_next;
+                    end
+                end
+
+                // round off the guard bits
+                assign x_round = (x[cordic] + (1 << (G-1))) >>> G;
+                assign y_round = (y[cordic] + (1 << (G-1))) >>> G;
+
+                always_ff @(posedge clk)
+                    entry <= {x_round[width-1:0], y_round[width-1:0]};
+            end else begin : lookup
+                localparam logic [(N/8+1)*2*width-1:0] octant = octant_table();
+
+                always_ff @(posedge clk)
+                    entry <= octant[2*width*m_octant +: 2*width];
+            end
+
+            assign w_cos = swap_q ? entry[width-1:0] : entry[2*width-1:width];
+            assign w_sin = swap_q ? entry[2*width-1:width] : entry[width-1:0];
+
+            // first quadrant cos - j*sin, second quadrant -j times that
+            assign twiddle = quadrant_q ? {-w_sin, -w_cos} : {w_cos, -w_sin};
+        end else begin
+            localparam logic [N*width-1:0] twiddles = twiddle_table();
+
+            always_ff @(posedge clk) begin
+                twiddle <= twiddles[2*width*twiddle_address +: 2*width];
+            end
+        end
+    endgenerate
+
+endmodule
+
+// Window ROM - coefficient for sample n of an N-sample frame, computed at
+// elaboration in the twiddles' Q1.(width-1) scale:
+//   select 0: rectangular, 1: Hann, 2: Hamming, 3: Blackman-Harris (4-term)
+// all periodic (DFT-even), so w[n] = w[N - n]. Each table holds n < N/2 and
+// n >= N/2 reads entry N - n; the centre, where every window peaks at 1, is a
+// constant. Three N/2-word tables, read with one cycle of latency.
+module window_rom #(parameter N=512, width=16)
+                  (input logic clk,
+                   input logic [1:0] select,
+                   input logic [$clog2(N)-1:0] index,
+                   output logic [width-1:0] coeff);
+
+    localparam M = $clog2(N);
+    localparam real pi    = 3.141592653589793;
+    localparam real scale = 2.0**(width-1) - 1;
+
+    function automatic logic [N/2-1:0][width-1:0] window_table(input int kind);
+        real angle, w;
+        for (int n = 0; n < N/2; n++) begin
+            angle = 2.0 * pi * n / N;
+            case (kind)
+                1:       w = 0.5 - 0.5 * $cos(angle);
+                2:       w = 0.54 - 0.46 * $cos(angle);
+                default: w = 0.35875 - 0.48829 * $cos(angle) + 0.14128 * $cos(2.0 * angle)
+                             - 0.01168 * $cos(3.0 * angle);
+            endcase
+            window_table[n] = $rtoi(w * scale + 0.5);
+        end
+    endfunction
+
+    localparam logic [N/2-1:0][width-1:0] HANN     = window_table(1);
+    localparam logic [N/2-1:0][width-1:0] HAMMING  = window_table(2);
+    localparam logic [N/2-1:0][width-1:0] BLACKMAN = window_table(3);
+
+    logic [M-2:0] n;
+    logic         centre;
+    logic [1:0]   select_q;
+    logic [width-1:0] hann_q, hamming_q, blackman_q;
+
+    // fold the second half onto the first
+    assign n = index[M-1] ? N - index : index[M-2:0];
+    assign centre = (index == N/2);
+
+    always_ff @(posedge clk) begin
+        hann_q     <= HANN[n];
+        hamming_q  <= HAMMING[n];
+        blackman_q <= BLACKMAN[n];
+        select_q   <= centre ? 2'd0 : select;
+    end
+
+    always_comb
+        case (select_q)
+            2'd0:    coeff = (1 << (width-1)) - 1;
+            2'd1:    coeff = hann_q;
+            2'd2:    coeff = hamming_q;
+            default: coeff = blackman_q;
+        endcase
+
+endmodule
+
+// Delay line of 'depth' registers (depth = 0 is a wire), used to line up
+// addresses and control with the pipelined datapath.
+module delay #(parameter width=1, depth=1)
+   (input logic              clk,
+    input logic [width-1:0]  d,
+    output logic [width-1:0] q);
+
+    generate
+        if (depth == 0) begin
+            assign q = d;
+        end else begin
+            logic [width-1:0] stages [depth-1:0];
+
+            always_ff @(posedge clk) begin
+                stages[0] <= d;
+                for (int i = 1; i < depth; i++) stages[i] <= stages[i-1];
+            end
+
+            assign q = stages[depth-1];
+        end
+    endgenerate
+
+endmodule
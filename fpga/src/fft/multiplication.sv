@@ -0,0 +1,259 @@
+// multiplication.sv - Butterflies and multipliers (Brian's Architecture)
+
+// Renamed from 'fft_butterfly' to match 'fft_controller' instantiation
+module butterfly_unit #(parameter width=16)
+   (input logic [2*width-1:0]  a,       // Input A (Upper Leg)
+    input logic [2*width-1:0]  b,       // Input B (Lower Leg)
+    input logic [2*width-1:0]  twiddle, // Twiddle Factor
+    output logic [2*width-1:0] aout,    // Output A
+    output logic [2*width-1:0] bout);   // Output B
+   
+   logic signed [width-1:0]    a_re, a_im, aout_re, aout_im, bout_re, bout_im;
+   logic signed [width-1:0]    b_re_mult, b_im_mult;
+   logic [2*width-1:0]         b_mult;
+
+   // Unpack the 32-bit complex inputs
+   assign a_re = a[2*width-1:width];
+   assign a_im = a[width-1:0];
+
+   // Multiply Lower Leg (b) by Twiddle Factor
+   complex_mult #(width) twiddle_mult(b, twiddle, b_mult);
+   
+   assign b_re_mult = b_mult[2*width-1:width];
+   assign b_im_mult = b_mult[width-1:0];
+
+   // Butterfly "Criss-Cross" Additions/Subtractions
+   // A_out = A + (B * W)
+   assign aout_re = a_re + b_re_mult;
+   assign aout_im = a_im + b_im_mult;
+   
+   // B_out = A - (B * W)
+   assign bout_re = a_re - b_re_mult;
+   assign bout_im = a_im - b_im_mult;
+
+   // Repack into 32-bit complex outputs
+   assign aout = {aout_re, aout_im};
+   assign bout = {bout_re, bout_im};
+
+endmodule 
+
+
+// Pipelined butterfly. depth selects which register stages are present:
+//   depth >= 1: registered multiplier outputs
+//   depth >= 2: registered inputs (RAM read data and twiddle)
+//   depth >= 3: registered outputs
+// Latency is depth cycles; depth = 0 behaves like butterfly_unit.
+// gauss = 1 uses the 3-multiplier complex product (see complex_mult_pipe).
+// scale halves both legs on the way in (block floating point).
+module butterfly_pipe #(parameter width=16, depth=0, gauss=0)
+   (input logic                clk,
+    input logic                scale,   // shift a and b right by one
+    input logic [2*width-1:0]  a,       // Input A (Upper Leg)
+    input logic [2*width-1:0]  b,       // Input B (Lower Leg)
+    input logic [2*width-1:0]  twiddle, // Twiddle Factor
+    output logic [2*width-1:0] aout,    // Output A
+    output logic [2*width-1:0] bout);   // Output B
+
+   logic [2*width-1:0]         a_scaled, b_scaled, a_in, b_in, tw_in, a_mult, b_mult;
+   logic signed [width-1:0]    a_re, a_im, aout_re, aout_im, bout_re, bout_im;
+   logic signed [width-1:0]    b_re_mult, b_im_mult;
+
+   // Block floating point: arithmetic shift of each part
+   assign a_scaled = scale ? {$signed(a[2*width-1:width]) >>> 1, $signed(a[width-1:0]) >>> 1} : a;
+   assign b_scaled = scale ? {$signed(b[2*width-1:width]) >>> 1, $signed(b[width-1:0]) >>> 1} : b;
+
+   // Input registers
+   delay #(6*width, depth >= 2) in_reg(clk, {a_scaled, b_scaled, twiddle}, {a_in, b_in, tw_in});
+
+   // Multiply Lower Leg (b) by Twiddle Factor, A follows alongside
+   complex_mult_pipe #(width, depth >= 1, gauss) twiddle_mult(clk, b_in, tw_in, b_mult);
+   delay #(2*width, depth >= 1) a_reg(clk, a_in, a_mult);
+
+   assign a_re = a_mult[2*width-1:width];
+   assign a_im = a_mult[width-1:0];
+   assign b_re_mult = b_mult[2*width-1:width];
+   assign b_im_mult = b_mult[width-1:0];
+
+   // Butterfly "Criss-Cross" Additions/Subtractions
+   assign aout_re = a_re + b_re_mult;
+   assign aout_im = a_im + b_im_mult;
+   assign bout_re = a_re - b_re_mult;
+   assign bout_im = a_im - b_im_mult;
+
+   // Output registers
+   delay #(4*width, depth >= 3) out_reg(clk, {aout_re, aout_im, bout_re, bout_im}, {aout, bout});
+
+endmodule
+
+
+// Radix-2^2 butterfly: two chained radix-2 levels over a group of four
+// points (x00, x01, x10, x11), spread over an even/odd pair of cycles so it
+// still only needs two RAM reads and two RAM writes per cycle.
+//   even: reads (x00, x01) with w1, second stage does the previous group's (y01, y11)
+//   odd:  reads (x10, x11) with w1, second stage does this group's (y00, y10) using w2
+// The twiddle input is w1 on even cycles and w2 on odd cycles; the odd
+// column uses -j*w2, so only one ROM lookup is needed per cycle.
+// Each stage is a butterfly_pipe, so the (y00, y10) column comes out
+// 2*depth cycles after its odd read and (y01, y11) one cycle later.
+// With r4 low it is a plain radix-2 butterfly (the final level), latency depth.
+// scale_1 and scale_2 halve the inputs of the first and second stage.
+module butterfly_r22 #(parameter width=16, depth=0, gauss=0)
+   (input logic                clk,
+    input logic                r4,      // radix-2^2 pass
+    input logic                phase,   // 0: even cycle, 1: odd cycle
+    input logic                scale_1, scale_2,
+    input logic [2*width-1:0]  a,       // Input A (Upper Leg)
+    input logic [2*width-1:0]  b,       // Input B (Lower Leg)
+    input logic [2*width-1:0]  twiddle, // Twiddle Factor
+    output logic [2*width-1:0] aout,    // Output A
+    output logic [2*width-1:0] bout);   // Output B
+
+   logic                       phase_d;
+   logic [2*width-1:0]         tw_prev, tw_1, tw_d, tw_d_prev, tw_2, tw_2_mj;
+   logic [2*width-1:0]         u_a, u_b, u00, u01, u11;
+   logic [2*width-1:0]         s2_a, s2_b, r4_aout, r4_bout;
+
+   // first stage: both pairs of the group use w1 (held over for the odd cycle)
+   assign tw_1 = phase ? tw_prev : twiddle;
+   butterfly_pipe #(width, depth, gauss) stage1(clk, scale_1, a, b, tw_1, u_a, u_b);
+
+   // first stage results arrive depth cycles late; w2 and the phase follow them
+   delay #(2*width+1, depth) align(clk, {phase, twiddle}, {phase_d, tw_d});
+
+   always_ff @(posedge clk) begin
+      tw_prev   <= twiddle;
+      tw_d_prev <= tw_d;
+      if (!phase_d) begin
+         u00 <= u_a;
+         u01 <= u_b;
+      end else begin
+         u11 <= u_b;
+      end
+   end
+
+   // -j * w2 = {w2_im, -w2_re}
+   assign tw_2_mj = {tw_d_prev[width-1:0], -tw_d_prev[2*width-1:width]};
+
+   // second stage: (u00, u10) with w2 now, (u01, u11) with -j*w2 next cycle
+   assign s2_a = phase_d ? u00 : u01;
+   assign s2_b = phase_d ? u_a : u11;
+   assign tw_2 = phase_d ? tw_d : tw_2_mj;
+   butterfly_pipe #(width, depth, gauss) stage2(clk, scale_2, s2_a, s2_b, tw_2, r4_aout, r4_bout);
+
+   assign aout = r4 ? r4_aout : u_a;
+   assign bout = r4 ? r4_bout : u_b;
+
+endmodule
+
+
+// Standard Signed Multiplier with Truncation
+module mult #(parameter width=16)
+   (input logic signed [width-1:0]  a,
+    input logic signed [width-1:0]  b,
+    output logic signed [width-1:0] out);
+   
+   logic [2*width-1:0]              untruncated_out;
+   
+   // Perform full precision multiply
+   assign untruncated_out = a * b;
+   
+   // Truncate back to 16 bits (divide by 2^15 to keep fixed point scale)
+   // This keeps the decimal point in the correct place for Q1.15 format
+   assign out = untruncated_out[2*width-2:width-1] + untruncated_out[width-2];
+   
+endmodule 
+
+
+// Complex Multiplier: (a + ji) * (c + jd)
+module complex_mult #(parameter width=16)
+   (input logic [2*width-1:0]  a,
+    input logic [2*width-1:0]  b,
+    output logic [2*width-1:0] out);
+   
+   logic signed [width-1:0]    a_re, a_im, b_re, b_im, out_re, out_im;
+   
+   assign a_re = a[2*width-1:width]; 
+   assign a_im = a[width-1:0];
+   assign b_re = b[2*width-1:width]; 
+   assign b_im = b[width-1:0];
+
+   logic signed [width-1:0]    a_re_b_re, a_im_b_im, a_re_b_im, a_im_b_re;
+
+   // Four Real Multiplications
+   mult #(width) m1 (a_re, b_re, a_re_b_re); // Real * Real
+   mult #(width) m2 (a_im, b_im, a_im_b_im); // Imag * Imag
+   mult #(width) m3 (a_re, b_im, a_re_b_im); // Real * Imag
+   mult #(width) m4 (a_im, b_re, a_im_b_re); // Imag * Real
+
+   // Complex Math: 
+   // Real = (ac - bd)
+   assign out_re = (a_re_b_re) - (a_im_b_im);
+   // Imag = (ad + bc)
+   assign out_im = (a_re_b_im) + (a_im_b_re);
+   
+   assign out = {out_re, out_im};
+
+endmodule
+
+
+// Complex multiplier with optional product registers.
+// gauss = 0: four mult instances, bit-exact with complex_mult.
+// gauss = 1: three multiplies on width+1 bit pre-added operands,
+//   k1 = c(a + b), k2 = a(d - c), k3 = b(c + d), re = k1 - k3, im = k1 + k2,
+//   rounded once after the sum. Saves a multiplier, but the operands no
+//   longer fit a 16x16 SB_MAC16 directly.
+module complex_mult_pipe #(parameter width=16, registered=1, gauss=0)
+   (input logic                clk,
+    input logic [2*width-1:0]  a,
+    input logic [2*width-1:0]  b,
+    output logic [2*width-1:0] out);
+
+   logic signed [width-1:0]    a_re, a_im, b_re, b_im, out_re, out_im;
+
+   assign a_re = a[2*width-1:width];
+   assign a_im = a[width-1:0];
+   assign b_re = b[2*width-1:width];
+   assign b_im = b[width-1:0];
+
+   generate
+      if (gauss) begin
+         logic signed [width:0]     a_sum, b_diff, b_sum;
+         logic signed [2*width:0]   k1, k2, k3, k1_q, k2_q, k3_q;
+         logic signed [2*width+1:0] re_full, im_full;
+
+         assign a_sum  = a_re + a_im;
+         assign b_diff = b_im - b_re;
+         assign b_sum  = b_re + b_im;
+
+         assign k1 = a_sum * b_re;
+         assign k2 = b_diff * a_re;
+         assign k3 = b_sum * a_im;
+
+         delay #(6*width+3, registered) product_reg(clk, {k1, k2, k3}, {k1_q, k2_q, k3_q});
+
+         assign re_full = k1_q - k3_q;
+         assign im_full = k1_q + k2_q;
+
+         // Same Q1.15 truncation with rounding as mult
+         assign out_re = re_full[2*width-2:width-1] + re_full[width-2];
+         assign out_im = im_full[2*width-2:width-1] + im_full[width-2];
+      end else begin
+         logic signed [width-1:0]   a_re_b_re, a_im_b_im, a_re_b_im, a_im_b_re;
+         logic signed [width-1:0]   a_re_b_re_q, a_im_b_im_q, a_re_b_im_q, a_im_b_re_q;
+
+         mult #(width) m1 (a_re, b_re, a_re_b_re); // Real * Real
+         mult #(width) m2 (a_im, b_im, a_im_b_im); // Imag * Imag
+         mult #(width) m3 (a_re, b_im, a_re_b_im); // Real * Imag
+         mult #(width) m4 (a_im, b_re, a_im_b_re); // Imag * Real
+
+         delay #(4*width, registered) product_reg(clk, {a_re_b_re, a_im_b_im, a_re_b_im, a_im_b_re},
+                                                  {a_re_b_re_q, a_im_b_im_q, a_re_b_im_q, a_im_b_re_q});
+
+         assign out_re = a_re_b_re_q - a_im_b_im_q;
+         assign out_im = a_re_b_im_q + a_im_b_re_q;
+      end
+   endgenerate
+
+   assign out = {out_re, out_im};
+
+endmodule
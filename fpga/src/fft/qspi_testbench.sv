@@ -0,0 +1,136 @@
+// Loopback test of the link on four lanes: a behavioural QUADSPI master
+// (indirect mode, as the MCU driver sets it up) writes a frame of samples,
+// the testbench hands them back as result words, and the master reads them
+// out again. Checks every byte, the mode and status commands, and prints the
+// clocks each direction took against a one-lane SPI.
+module qspi_testbench();
+
+   localparam N = 64;
+   localparam DUMMY = 2;             // one dummy byte
+   localparam STATUS = 16'h0502;     // frame 5 read, busy
+   localparam WORDS = N/4;           // four samples per 32-bit result word
+
+   logic        sck, cs_n, reset, master_oe, qio_oe;
+   logic [3:0]  master_out, qio_out;
+   wire  [3:0]  qio;
+   logic        sample_write, loaded;
+   logic [5:0]  sample_index;
+   logic [7:0]  sample;
+   logic [7:0]  out_word;
+   logic [31:0] out_data, word;
+   logic [7:0]  mode;
+   logic [3:0]  size;
+   logic [15:0] status;
+   logic [7:0]  sent [0:N-1];
+   logic [7:0]  looped [0:N-1];
+   integer      clocks, write_clocks, read_clocks, errors;
+
+   // status_in: busy, frame count 5 in Gray code
+   fft_spi #(N, 16, N, 4) dut(sck, cs_n, reset, qio, qio_out, qio_oe, 3'd0, {1'b1, 8'h07}, mode, size,
+                              sample_write, sample_index, sample, loaded, out_word, out_data);
+
+   assign qio = master_oe ? master_out : 4'bz;
+   assign qio = qio_oe ? qio_out : 4'bz;
+
+   // loopback: the samples come back as result words, four to a word, one
+   // sck after out_word like the output buffer's RAM
+   always @(posedge sck) begin
+      if (sample_write) looped[sample_index] <= sample;
+      out_data <= (out_word < WORDS) ? {looped[4*out_word], looped[4*out_word+1],
+                                        looped[4*out_word+2], looped[4*out_word+3]} : 32'h0;
+   end
+
+   // the master changes qio while sck is low and samples it on the rising edge
+   task clock();
+      #10 sck = 1; clocks = clocks + 1;
+      #10 sck = 0;
+   endtask
+
+   task begin_transaction(input logic [7:0] instruction);
+      cs_n = 0; master_oe = 1;
+      master_out = instruction[7:4]; clock();
+      master_out = instruction[3:0]; clock();
+   endtask
+
+   task end_transaction();
+      master_oe = 0;
+      #10 cs_n = 1;
+      #10;
+   endtask
+
+   initial
+     begin
+	sck = 0; cs_n = 1; master_oe = 0; clocks = 0; errors = 0;
+	for (int i = 0; i < N; i++) sent[i] = $urandom;
+
+	reset = 1; clock(); clock(); reset = 0;
+
+	// write the frame
+	clocks = 0;
+	begin_transaction(8'h01);
+	for (int i = 0; i < N; i++) begin
+	   master_out = sent[i][7:4]; clock();
+	   master_out = sent[i][3:0]; clock();
+	end
+	end_transaction();
+	write_clocks = clocks;
+	if (!loaded) begin
+	   $display("Error: fft_loaded low after %0d samples", N);
+	   errors = errors + 1;
+	end
+
+	// read it back
+	clocks = 0;
+	begin_transaction(8'h02);
+	master_oe = 0;
+	repeat (DUMMY) clock();
+	for (int w = 0; w < WORDS; w++) begin
+	   for (int n = 0; n < 8; n++) begin
+	      #10 sck = 1; clocks = clocks + 1;
+	      word = {word[27:0], qio};
+	      #10 sck = 0;
+	   end
+	   for (int b = 0; b < 4; b++)
+	     if (word[31-8*b -: 8] !== sent[4*w+b]) begin
+		$display("Error @ sample %0d: sent %h, read back %h", 4*w+b, sent[4*w+b], word[31-8*b -: 8]);
+		errors = errors + 1;
+	     end
+	end
+	end_transaction();
+	read_clocks = clocks;
+
+	// set the mode register, then read the status
+	begin_transaction(8'h04);
+	master_out = 4'hA; clock();
+	master_out = 4'h5; clock();
+	end_transaction();
+	if (mode !== 8'hA5) begin
+	   $display("Error: mode %h after setting A5", mode);
+	   errors = errors + 1;
+	end
+
+	begin_transaction(8'h03);
+	master_oe = 0;
+	repeat (DUMMY) clock();
+	for (int n = 0; n < 4; n++) begin
+	   #10 sck = 1;
+	   status = {status[11:0], qio};
+	   #10 sck = 0;
+	end
+	end_transaction();
+	if (status !== STATUS) begin
+	   $display("Error: status %h, expected %h", status, STATUS);
+	   errors = errors + 1;
+	end
+
+	if (write_clocks != 2 + 2*N || read_clocks != 2 + DUMMY + 2*N) begin
+	   $display("Error: expected %0d write and %0d read clocks", 2 + 2*N, 2 + DUMMY + 2*N);
+	   errors = errors + 1;
+	end
+
+	$display("QSPI loopback: %0d bits each way, write %0d clocks, read %0d clocks (one-lane SPI: %0d), %0d errors",
+		 8*N, write_clocks, read_clocks, 8*N, errors);
+	$display("QSPI test complete.");
+	$stop;
+     end
+endmodule // qspi_testbench
@@ -0,0 +1,469 @@
+// spectrum.sv - Post-processing of the core's {re, im} result words
+
+// Output formatter between the core and the output buffer. Each result is
+// turned into the selected format, left-aligned in a 2*width-bit word (the
+// SPI only sends the top word_bits of it):
+//   format 0: full complex {re, im}, 2*width bits
+//   format 1: packed complex, the top 8 bits of re and of im (16 bits)
+//   format 2: magnitude |X| from fft_magnitude, saturated to 16 bits
+//             (width > 16 drops the low bits first)
+//   format 3: log-magnitude, 20 log10 |X|^2 (half dB per LSB), 8 bits
+//   format 4: power |X|^2 from fft_magnitude, 2*width bits
+//   format 5: band energies from fft_filterbank, 2*width bits: 'bands' mel
+//             bands, then no other words for the frame
+//   format 6: the same with 1/3-octave bands
+//   format 7: the same with linear bands
+// The format and accumulation mode are taken at start (out_start), so they
+// only change between frames. With accumulate = 1 the power formats (3 to 7)
+// go through fft_accumulator first, per the mode pins: 0 off, 1 average of
+// 2^average_log2 frames, 2 exponential smoothing by 2^-smoothing, 3 max-hold;
+// the other formats always pass each frame as is. Five cycles of latency;
+// start, done and the exponent go through the same delays so the output
+// buffer sees them in step with the data, and frames the accumulator holds
+// back never reach it. Band formats raise done once per band instead of per
+// bin. bands = 0 leaves the filterbank out (formats 5 to 7 are then power);
+// spectrum is the number of bins from DC to fs/2 and sample_rate the sample
+// rate in Hz, for the band tables.
+module fft_format #(parameter width=16, mag_cordic=0, accumulate=1, bins=512, average_log2=3, smoothing=3,
+                              bands=0, spectrum=bins/2+1, sample_rate=16000)
+                  (input logic                  clk, reset,
+                   input logic [2:0]            format,
+                   input logic [1:0]            mode,
+                   input logic                  start, done,
+                   input logic [3:0]            exponent,
+                   input logic [2*width-1:0]    data,
+                   output logic [2:0]           frame_format,
+                   output logic                 start_out, done_out,
+                   output logic [3:0]           exponent_out,
+                   output logic [2*width-1:0]   data_out);
+
+    localparam PW    = 2*width;               // power bits
+    localparam EW    = $clog2(PW);            // leading-one position bits
+    localparam F     = 4;                     // mantissa bits into the dB table
+    localparam SHIFT = (width > 16) ? width - 16 : 0;
+
+    // 20 log10(2^e * (1 + (f + 1/2) / 2^F)), saturated to 8 bits
+    function automatic logic [(1 << (EW + F))-1:0][7:0] db_table();
+        real db;
+        for (int e = 0; e < (1 << EW); e++)
+            for (int f = 0; f < (1 << F); f++) begin
+                db = 20.0 * $log10((2.0 ** e) * (1.0 + (f + 0.5) / (1 << F)));
+                db_table[(e << F) | f] = (e >= PW) ? 0 : (db > 255.0) ? 8'd255 : $rtoi(db + 0.5);
+            end
+    endfunction
+
+    localparam logic [(1 << (EW + F))-1:0][7:0] DB = db_table();
+
+    logic [2:0]              format_2, format_4;
+    logic                    start_3, done_3, start_4, done_4, band_4, band_emit;
+    logic [3:0]              exponent_3, exponent_4;
+    logic [PW-1:0]           band_power;
+    logic [1:0]              start_mode, mode_2;
+    logic [2*width-1:0]      data_2, data_4, formatted;
+    logic [PW-1:0]           power, power_4, normalized;
+    logic [width:0]          magnitude, magnitude_4;
+    logic                    start_2, done_2, publish, frame_publish;
+    logic [3:0]              exponent_2, exponent_5;
+    logic [EW-1:0]           lead;
+    logic [F-1:0]            mantissa;
+    logic [31:0]             mag_wide;
+    logic [15:0]             mag_16;
+
+    always_ff @(posedge clk) begin
+        if (reset)      frame_format <= 0;
+        else if (start) frame_format <= format;
+    end
+
+    assign start_mode = (format >= 3'd3) ? mode : 2'd0;
+
+    // stages 1 and 2: power and magnitude, the word, format and control alongside
+    fft_magnitude #(width, mag_cordic) magnitude_unit(clk, data, power, magnitude);
+    delay #(2*width+3, 2) align(clk, {data, frame_format}, {data_2, format_2});
+    delay #(8, 2) control_2(clk, {start, done, exponent, start_mode}, {start_2, done_2, exponent_2, mode_2});
+
+    // stages 3 and 4: the accumulated power
+    generate
+        if (accumulate) begin : accumulation
+            logic [3:0] acc_exponent;
+
+            fft_accumulator #(bins, width, average_log2, smoothing) accumulator(clk, reset, mode_2, start_2, done_2,
+                                                                               exponent_2, power, publish, frame_publish,
+                                                                               acc_exponent, power_4);
+            // the accumulator settles the frame's exponent at start, ahead of start_out
+            assign exponent_out = acc_exponent;
+        end else begin : pass
+            delay #(PW, 2) power_delay(clk, power, power_4);
+            assign publish = 1'b1;
+            assign frame_publish = 1'b1;
+            assign exponent_out = exponent_5;
+        end
+    endgenerate
+
+    delay #(3*width+4, 2) align_4(clk, {data_2, format_2, magnitude}, {data_4, format_4, magnitude_4});
+    delay #(6, 1) control_3(clk, {start_2 && publish, done_2 && frame_publish, exponent_2}, {start_3, done_3, exponent_3});
+    delay #(6, 1) control_4(clk, {start_3, done_3, exponent_3}, {start_4, done_4, exponent_4});
+
+    // stage 4: the band energies, looked up a stage ahead
+    generate
+        if (bands > 0) begin : filterbank
+            fft_filterbank #(width, bands, spectrum, sample_rate) band_unit(clk, start_3, done_3, format_2[1:0] - 2'd1,
+                                                                            power_4, band_emit, band_power);
+            assign band_4 = (format_4 >= 3'd5);
+        end else begin : no_filterbank
+            assign band_emit  = 1'b0;
+            assign band_power = '0;
+            assign band_4     = 1'b0;
+        end
+    endgenerate
+
+    // stage 5: the selected format
+    always_comb begin
+        lead = 0;
+        for (int i = 0; i < PW; i++)
+            if (power_4[i]) lead = i;
+        normalized = power_4 << (PW - 1 - lead);
+        mantissa   = normalized[PW-2 -: F];
+
+        mag_wide = magnitude_4 >> SHIFT;
+        mag_16   = (mag_wide > 32'hFFFF) ? 16'hFFFF : mag_wide[15:0];
+
+        formatted = 0;
+        case (format_4)
+            3'd0:    formatted = data_4;
+            3'd1:    formatted[2*width-1 -: 16] = {data_4[2*width-1 -: 8], data_4[width-1 -: 8]};
+            3'd2:    formatted[2*width-1 -: 16] = mag_16;
+            3'd3:    formatted[2*width-1 -: 8]  = (power_4 == 0) ? 8'd0 : DB[{lead, mantissa}];
+            default: formatted = band_4 ? band_power : power_4;
+        endcase
+    end
+
+    always_ff @(posedge clk) begin
+        data_out   <= formatted;
+        start_out  <= start_4;
+        done_out   <= band_4 ? band_emit : done_4;
+        exponent_5 <= exponent_4;
+    end
+
+endmodule
+
+// Spectral accumulator: one word per bin, folding each frame's power into it
+// as the bins go by (read-modify-write on a RAM, one bin per cycle, two
+// cycles of latency):
+//   mode 0: off, the power passes through
+//   mode 1: mean of K = 2^average_log2 frames (Welch); only every K-th frame
+//           is published, so the host reads once per K
+//   mode 2: exponential smoothing, y += (x - y) / 2^smoothing
+//   mode 3: max-hold, y = max(y, x)
+// Modes 2 and 3 publish every frame, so the output buffer always holds the
+// current state for the host to read on demand. A mode change starts over
+// at the next frame. Frames with different block exponents are aligned to
+// the larger one (the other side shifts right by twice the difference, as
+// this is power), and that exponent goes out with the result. publish tells,
+// from start on, whether this frame reaches the output, and frame_publish
+// the same for the frame whose bins are going by. They differ when start
+// comes with the last bin of the frame before (the streaming core), which
+// also still folds in under that frame's mode and exponents.
+module fft_accumulator #(parameter bins=512, width=16, average_log2=3, smoothing=3)
+                       (input logic                 clk, reset,
+                        input logic [1:0]           mode,
+                        input logic                 start, valid,
+                        input logic [3:0]           exponent,
+                        input logic [2*width-1:0]   power,
+                        output logic                publish, frame_publish,
+                        output logic [3:0]          exponent_out,
+                        output logic [2*width-1:0]  power_out);
+
+    localparam PW = 2*width;
+    localparam FW = (average_log2 > smoothing) ? average_log2 : smoothing;  // sum headroom / smoothing fraction
+    localparam AW = PW + FW;
+    localparam K  = 1 << average_log2;
+    localparam B  = $clog2(bins);
+
+    logic [1:0]             frame_mode, bin_mode;
+    logic [average_log2:0]  frame_count, next_count;
+    logic                   restart, fresh, first, bin_first, next_publish;
+    logic [4:0]             diff, shift_acc, shift_in, bin_shift_acc, bin_shift_in;
+    logic [B-1:0]           bin, bin_1;
+    logic                   valid_1;
+    logic [PW-1:0]          power_1;
+    logic [AW-1:0]          acc_q, aligned_acc, aligned_in, acc, result;
+
+    // per frame: where it falls in the K, and how to align the exponents
+    assign restart      = (mode != frame_mode) || (mode == 2'd0);
+    assign next_count   = (restart || frame_count == K-1) ? '0 : frame_count + 1'b1;
+    assign fresh        = restart || (mode == 2'd1 && next_count == 0);
+    assign next_publish = (mode != 2'd1) || (next_count == K-1);
+    assign publish      = start ? next_publish : frame_publish;
+    assign diff         = {1'b0, exponent} - {1'b0, exponent_out};
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            frame_mode    <= 0;
+            frame_count   <= K-1;
+            frame_publish <= 1;
+            first         <= 1;
+            exponent_out  <= 0;
+            shift_acc     <= 0;
+            shift_in      <= 0;
+        end else if (start) begin
+            frame_mode    <= mode;
+            frame_count   <= next_count;
+            frame_publish <= next_publish;
+            first         <= fresh;
+            shift_acc     <= (!fresh && !diff[4]) ? diff << 1 : 5'd0;
+            shift_in      <= (!fresh &&  diff[4]) ? (-diff) << 1 : 5'd0;
+            if (fresh || !diff[4]) exponent_out <= exponent;
+        end
+    end
+
+    // per bin: read the bin's word while its power is on the way, write back a cycle later
+    always_ff @(posedge clk) begin
+        if (start)      bin <= 0;
+        else if (valid) bin <= bin + 1'b1;
+        bin_1   <= bin;
+        valid_1 <= valid;
+        power_1 <= power;
+        // the frame settings a cycle on, in step with bin_1
+        bin_mode      <= frame_mode;
+        bin_first     <= first;
+        bin_shift_acc <= shift_acc;
+        bin_shift_in  <= shift_in;
+    end
+
+    ram #(1 << B, AW) acc_ram(clk, valid_1, bin_1, bin, acc, acc_q);
+
+    always_comb begin
+        aligned_acc = bin_first ? '0 : acc_q >> bin_shift_acc;
+        aligned_in  = AW'(power_1) >> bin_shift_in;
+        case (bin_mode)
+            2'd2:    acc = bin_first ? aligned_in << smoothing
+                                     : aligned_acc + aligned_in - (aligned_acc >> smoothing);
+            2'd3:    acc = (aligned_in > aligned_acc) ? aligned_in : aligned_acc;
+            default: acc = aligned_acc + aligned_in;
+        endcase
+        case (bin_mode)
+            2'd1:    result = acc >> average_log2;
+            2'd2:    result = acc >> smoothing;
+            default: result = acc;
+        endcase
+    end
+
+    always_ff @(posedge clk)
+        power_out <= result[PW-1:0];
+
+endmodule
+
+// Band energies: sums of each frame's power bins 0 .. spectrum-1 (DC to
+// fs/2) into 'bands' bands, from a table computed at elaboration:
+//   kind 0: mel, triangles evenly spaced in mel from 0 to fs/2, each from
+//           its lower neighbour's peak to its upper one's
+//   kind 1: 1/3-octave, rectangles on the base-2 series (1 kHz centre,
+//           edges 2^(+-1/6) around it), the highest ending at or below fs/2
+//   kind 2: linear, equal rectangles from 0 to fs/2
+// Edges are rounded to bins and every band gets at least one bin of its
+// own (the low 1/3-octave and mel bands widen to one bin). Bins from
+// spectrum on (the negative frequencies of a complex frame) are ignored.
+// The table gives each bin a segment (the pair of bands it falls between)
+// and the upper band's weight t, in Q0.T: the lower band gets (1 - t) of
+// its power. The bins come in order, so only those two bands are open;
+// when the segment moves up, the lower one is complete and comes out
+// (emit, band), saturated to 2*width bits, one band per emit in order.
+// start, valid and kind (taken at start) go one cycle ahead of power, for
+// the table read; emit and band are combinational with power.
+module fft_filterbank #(parameter width=16, bands=40, spectrum=257, sample_rate=16000)
+                      (input logic                 clk, start, valid,
+                       input logic [1:0]           kind,
+                       input logic [2*width-1:0]   power,
+                       output logic                emit,
+                       output logic [2*width-1:0]  band);
+
+    localparam PW = 2*width;
+    localparam S  = spectrum;
+    localparam T  = 6;                        // weight bits
+    localparam SB = $clog2(bands + 2);        // segment bits
+    localparam BB = $clog2(S + 1);            // bin bits; bin S stands for all the ignored ones
+    localparam AW = PW + $clog2(S);
+    localparam real nyquist = sample_rate / 2.0;
+
+    // {segment, t} per kind and bin
+    function automatic logic [2:0][S:0][SB+T-1:0] band_table();
+        real f, mel_top, t;
+        int  corner [bands+2];
+        int  last, count, seg, top, w;
+        for (int kind = 0; kind < 3; kind++) begin
+            // corners in bins: bands + 2 triangle corners, or bands + 1 rectangle edges
+            last    = (kind == 0) ? bands + 1 : bands;
+            mel_top = 2595.0 * $log10(1.0 + nyquist / 700.0);
+            top     = $floor(3.0 * $ln(nyquist / 1000.0) / $ln(2.0) - 0.5);
+            for (int i = 0; i <= last; i++) begin
+                case (kind)
+                    0:       f = 700.0 * (10.0 ** (mel_top * i / (bands + 1) / 2595.0) - 1.0);
+                    1:       f = 1000.0 * 2.0 ** ((top - bands + i + 0.5) / 3.0);
+                    default: f = nyquist * i / bands;
+                endcase
+                corner[i] = $rtoi(f * (S - 1) / nyquist + 0.5);
+            end
+            // at least a bin apart, and all below bin S
+            for (int i = 1; i <= last; i++)
+                if (corner[i] <= corner[i-1]) corner[i] = corner[i-1] + 1;
+            if (corner[last] > S - 1) corner[last] = S - 1;
+            for (int i = last - 1; i >= 0; i--)
+                if (corner[i] >= corner[i+1]) corner[i] = corner[i+1] - 1;
+
+            for (int k = 0; k <= S; k++) begin
+                count = 0;
+                for (int i = 0; i <= last; i++)
+                    if (corner[i] <= k) count++;
+                if (k == S) count = last + 1;
+                t = 0.0;
+                if (kind != 0) begin
+                    seg = count;
+                end else begin
+                    // bin k lies between corners seg and seg + 1
+                    seg = (count == 0) ? 0 : count - 1;
+                    if (count >= 1 && count <= last)
+                        t = real'(k - corner[seg]) / (corner[seg+1] - corner[seg]);
+                end
+                w = $rtoi(t * (1 << T) + 0.5);
+                if (w > (1 << T) - 1) w = (1 << T) - 1;
+                band_table[kind][k] = {SB'(seg), T'(w)};
+            end
+        end
+    endfunction
+
+    localparam logic [2:0][S:0][SB+T-1:0] TABLE = band_table();
+
+    logic [1:0]      frame_kind;
+    logic [BB-1:0]   bin;
+    logic [SB+T-1:0] entry;
+    logic [SB-1:0]   seg;
+    logic [T-1:0]    t;
+    logic            valid_1, start_1, advance;
+    logic [PW+T-1:0] weighted;
+    logic [PW-1:0]   rise, fall;
+    logic [AW-1:0]   falling, rising;
+
+    // stage 1: the bin's table entry
+    always_ff @(posedge clk) begin
+        if (start) begin
+            frame_kind <= (kind > 2'd2) ? 2'd2 : kind;
+            bin <= 0;
+        end else if (valid && bin != S) begin
+            bin <= bin + 1'b1;
+        end
+        entry   <= TABLE[frame_kind][bin];
+        valid_1 <= valid;
+        start_1 <= start;
+    end
+
+    // stage 2: split the power between the two open bands
+    assign t        = entry[T-1:0];
+    assign weighted = power * t;
+    assign rise     = weighted >> T;
+    assign fall     = power - rise;
+    assign advance  = (entry[SB+T-1:T] != seg);
+
+    always_ff @(posedge clk) begin
+        if (start_1) begin
+            seg <= 0;
+            falling <= 0;
+            rising <= 0;
+        end else if (valid_1) begin
+            if (advance) begin
+                seg <= entry[SB+T-1:T];
+                falling <= rising + fall;
+                rising <= rise;
+            end else begin
+                falling <= falling + fall;
+                rising <= rising + rise;
+            end
+        end
+    end
+
+    // the lower band of segment 0 is below the first band
+    assign emit = valid_1 && advance && (seg != 0);
+    assign band = (falling >> PW) ? '1 : falling[PW-1:0];
+
+endmodule
+
+// Power and magnitude of one {re, im} word per cycle, both out two cycles
+// later.
+//   power:     re^2 + im^2 at full precision, 2*width bits unsigned (two
+//              width x width multipliers; with the radix-2^2 core holding all
+//              eight UP5K DSPs they end up in fabric)
+//   magnitude: width + 1 bits unsigned. cordic = 0 takes max + 3/8 min of
+//              |re| and |im| (alpha-max-beta-min, +7%/-3% of |X|); cordic > 0
+//              runs that many CORDIC vectoring iterations and removes their
+//              gain with one constant multiply (0.8% of |X| at 4 iterations,
+//              0.2% at 6; from 8 on it is within 2 LSB)
+module fft_magnitude #(parameter width=16, cordic=0)
+                     (input logic                clk,
+                      input logic [2*width-1:0]  data,
+                      output logic [2*width-1:0] power,
+                      output logic [width:0]     magnitude);
+
+    logic signed [width-1:0]  re, im;
+    logic [width-1:0]         abs_re, abs_im;
+    logic [2*width-1:0]       re_sq, im_sq;
+
+    assign re = data[2*width-1:width];
+    assign im = data[width-1:0];
+    assign abs_re = re[width-1] ? -re : re;
+    assign abs_im = im[width-1] ? -im : im;
+
+    always_ff @(posedge clk) begin
+        re_sq <= abs_re * abs_re;
+        im_sq <= abs_im * abs_im;
+        power <= re_sq + im_sq;
+    end
+
+    generate
+        if (cordic) begin : vectoring
+            localparam G  = 2;                    // guard bits
+            localparam XW = width + G + 2;        // |X| * gain < 2^(width+1) * 2^G
+
+            function automatic logic [width:0] inverse_gain();
+                real k;
+                k = 1.0;
+                for (int i = 0; i < cordic; i++) k = k * $sqrt(1.0 + 2.0**(-2*i));
+                return $rtoi((2.0 ** width) / k + 0.5);
+            endfunction
+
+            localparam logic [width:0] INV_K = inverse_gain();
+
+            logic signed [XW-1:0] x [cordic:0];
+            logic signed [XW-1:0] y [cordic:0];
+            logic [XW-1:0]        x_1;
+            logic [XW+width:0]    scaled;
+
+            // rotate (|re|, |im|) onto the x axis; y's sign picks the direction
+            assign x[0] = abs_re << G;
+            assign y[0] = abs_im << G;
+
+            genvar i;
+            for (i = 0; i < cordic; i++) begin : iteration
+                assign x[i+1] = (y[i] >= 0) ? x[i] + (y[i] >>> i) : x[i] - (y[i] >>> i);
+                assign y[i+1] = (y[i] >= 0) ? y[i] - (x[i] >>> i) : y[i] + (x[i] >>> i);
+            end
+
+            always_ff @(posedge clk) begin
+                x_1 <= x[cordic];
+                magnitude <= scaled >> (width + G);
+            end
+
+            assign scaled = x_1 * INV_K + (1 << (width + G - 1));
+        end else begin : alpha_max_beta_min
+            logic [width-1:0] big, small;
+            logic [width:0]   magnitude_1;
+
+            assign big   = (abs_re > abs_im) ? abs_re : abs_im;
+            assign small = (abs_re > abs_im) ? abs_im : abs_re;
+
+            always_ff @(posedge clk) begin
+                magnitude_1 <= big + (small >> 2) + (small >> 3);
+                magnitude <= magnitude_1;
+            end
+        end
+    endgenerate
+
+endmodule
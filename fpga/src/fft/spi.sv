@@ -0,0 +1,451 @@
+// spi.sv - SPI/QUADSPI command link, samples in, formatted result words out
+
+// Register-style link to the MCU over 'lanes' data lines: 1 for SPI (din =
+// sdi, dout = sdo) or 4 for a QUADSPI master in indirect mode (din and dout
+// share the qio pins, dout_oe turns them around). Mode 0, MSB first: bits
+// are taken on posedge sck and driven on negedge. Each transaction (cs_n
+// low) starts with a command byte:
+//   SPI_WRITE_FRAME  0x01  'samples' samples of sample_bits (8, 12 or 16)
+//                          follow, packed back to back, MSB first
+//   SPI_READ_RESULTS 0x02  a dummy byte, then result words of the latest
+//                          complete frame, in its format's size (see
+//                          fft_format): 2*width bits for formats 0, 4
+//                          and the band formats 5 to 7, 16 for 1 and 2,
+//                          8 for 3; past the end reads zero
+//   SPI_READ_STATUS  0x03  a dummy byte, then the 16-bit status
+//   SPI_SET_MODE     0x04  one byte: {format[2:0], window[1:0],
+//                          averaging[1:0], inverse}
+//   SPI_SET_SIZE     0x05  one byte: log2 of the frame size for the frames
+//                          written after it, min_size to log2(N) (others
+//                          are ignored); a frame then takes samples * n / N,
+//                          which min_size keeps a whole number
+// Status is {frame count[7:0], 6'b0, busy, ready}: frames completed into
+// the output buffer (mod 256), busy while a frame waits for or is in the
+// core, and ready once a frame has completed since the last
+// SPI_READ_RESULTS. The MCU polls it (or waits for the done line) and reads
+// exactly when there is something to read. The dummy byte gives the status
+// time to cross over from clk (status_in is {busy, Gray-coded frame count})
+// and the result RAM time for the first word.
+// Nothing frame-sized is held here: samples go straight to the input
+// buffer's RAM (sample_write) and result words are fetched from the output
+// buffer's RAM one sck ahead of the shifter (out_word, out_data). out_word
+// rests at all ones outside SPI_READ_RESULTS, so the output buffer sees
+// every read start at word 0. cs_n resets the transaction asynchronously,
+// since sck stops between transactions.
+module fft_spi #(parameter N=512, width=16, samples=N, lanes=1, sample_bits=8, min_size=$clog2(N))(
+    input logic sck, cs_n, reset,
+    input logic [lanes-1:0] din,
+    output logic [lanes-1:0] dout,
+    output logic dout_oe,              // driving dout (reply)
+    input logic [2:0] format,          // of the frame being read
+    input logic [8:0] status_in,       // {busy, frame count (Gray)}, on clk
+    output logic [7:0] mode,           // from SPI_SET_MODE
+    output logic [3:0] size,           // from SPI_SET_SIZE, log2 of the frame size
+    output logic sample_write,
+    output logic [$clog2(N)-1:0] sample_index,
+    output logic [sample_bits-1:0] sample,
+    output logic fft_loaded,           // high from the last sample to the next SPI_WRITE_FRAME
+    output logic [$clog2(N)+1:0] out_word,
+    input  logic [2*width-1:0] out_data
+);
+    localparam SPI_WRITE_FRAME  = 8'h01;
+    localparam SPI_READ_RESULTS = 8'h02;
+    localparam SPI_READ_STATUS  = 8'h03;
+    localparam SPI_SET_MODE     = 8'h04;
+    localparam SPI_SET_SIZE     = 8'h05;
+    localparam BYTE  = 8 / lanes;      // clocks per byte
+    localparam REPLY = 2 * BYTE;       // first reply clock: after the command and dummy bytes
+    localparam SAMPLE = sample_bits / lanes;  // clocks per sample
+
+    function automatic int word_clocks_of(input logic [2:0] f);
+        return ((f == 1 || f == 2) ? 16 : (f == 3) ? 8 : 2*width) / lanes;
+    endfunction
+
+    logic [$clog2(REPLY):0] cnt;       // clocks since cs_n fell, saturating
+    logic [15:0] in_shift;
+    logic [7:0] in_byte, command;
+    logic writing, reading, replying, last_clock;
+    logic [$clog2(SAMPLE)-1:0] sample_clock;
+    logic [$clog2(samples):0] sample_cnt, frame_samples;
+    logic [$clog2(2*width):0] clock_cnt;
+    logic [$clog2(N)+1:0] word_cnt;
+    logic [2*width-1:0] out_shift_reg;
+    logic [1:0][8:0] status_sync;
+    logic [7:0] frame_count, read_count;
+    logic [15:0] status;
+
+    always_ff @(posedge sck or posedge cs_n) begin
+        if (cs_n) begin
+            cnt <= 0;
+            command <= 0;
+        end else begin
+            if (cnt == BYTE-1) command <= in_byte;
+            if (cnt != '1) cnt <= cnt + 1;
+        end
+    end
+
+    // Input Path: the command byte, then a mode byte or the samples
+    always_ff @(posedge sck)
+        in_shift <= {in_shift[15-lanes:0], din};
+
+    assign in_byte  = {in_shift[7-lanes:0], din};
+    assign writing  = (cnt >= BYTE) && (command == SPI_WRITE_FRAME);
+    assign reading  = (cnt >= BYTE) && (command == SPI_READ_RESULTS);
+    assign replying = (cnt >= REPLY) && (command == SPI_READ_RESULTS || command == SPI_READ_STATUS);
+
+    assign frame_samples = samples >> ($clog2(N) - size);
+
+    // samples need not be whole bytes (12 bits), so their clocks are counted out
+    always_ff @(posedge sck or posedge cs_n) begin
+        if (cs_n) begin
+            sample_clock <= 0;
+            sample_cnt <= 0;
+        end else if (writing && sample_cnt < frame_samples) begin
+            if (sample_clock == SAMPLE-1) begin
+                sample_clock <= 0;
+                sample_cnt <= sample_cnt + 1;
+            end else begin
+                sample_clock <= sample_clock + 1;
+            end
+        end
+    end
+
+    assign sample       = {in_shift[sample_bits-lanes-1:0], din};
+    assign sample_index = sample_cnt;
+    assign sample_write = !reset && writing && sample_clock == SAMPLE-1 && sample_cnt < frame_samples;
+
+    always_ff @(posedge sck) begin
+        if (reset) begin
+            fft_loaded <= 0;
+            mode <= 0;
+            size <= $clog2(N);
+        end else begin
+            // falls with the next command byte, so it toggles even when a
+            // frame is a single sample (or the last one is also the first)
+            if (cnt == BYTE-1 && in_byte == SPI_WRITE_FRAME) fft_loaded <= 0;
+            else if (sample_write && sample_index == frame_samples-1) fft_loaded <= 1;
+            if (command == SPI_SET_MODE && cnt == 2*BYTE-1) mode <= in_byte;
+            if (command == SPI_SET_SIZE && cnt == 2*BYTE-1 && in_byte >= min_size && in_byte <= $clog2(N))
+                size <= in_byte;
+        end
+    end
+
+    // Status: synchronised while the command and dummy bytes go by
+    always_ff @(posedge sck) begin
+        status_sync <= {status_sync[0], status_in};
+        if (reset) read_count <= 0;
+        else if (reading && cnt == BYTE) read_count <= frame_count;
+    end
+
+    // Gray to binary
+    always_comb
+        for (int i = 0; i < 8; i++)
+            frame_count[i] = ^(status_sync[1][7:0] >> i);
+
+    assign status = {frame_count, 6'b0, status_sync[1][8], frame_count != read_count};
+
+    // Output Path: the reply in words of the format's size (16 bits of
+    // status); word 0 is fetched from the start of the read, each next word
+    // during the last clock of the one before
+    assign last_clock = (clock_cnt == ((command == SPI_READ_STATUS) ? 16 / lanes : word_clocks_of(format)) - 1);
+    assign out_word   = reading ? word_cnt : '1;
+
+    always_ff @(negedge sck or posedge cs_n) begin
+        if (cs_n) begin
+            clock_cnt <= 0;
+            word_cnt <= 0;
+            out_shift_reg <= 0;
+            dout_oe <= 0;
+        end else if (replying) begin
+            dout_oe <= 1;
+            if (clock_cnt != 0)                    out_shift_reg <= out_shift_reg << lanes;
+            else if (command == SPI_READ_RESULTS)  out_shift_reg <= out_data;
+            else                                   out_shift_reg <= (word_cnt == 0) ? {status, {(2*width-16){1'b0}}} : '0;
+            if (last_clock) begin
+                clock_cnt <= 0;
+                word_cnt <= word_cnt + 1;
+            end else begin
+                clock_cnt <= clock_cnt + 1;
+            end
+        end
+    end
+
+    assign dout = out_shift_reg[2*width-1 -: lanes];
+endmodule
+
+// Input Buffer: SPI samples -> sample RAM -> window -> 2*width-bit Core
+// The RAM is written on sck and read on clk. Once a frame is in, it is
+// loaded into the core one word per cycle. Each sample is multiplied by its
+// window coefficient (window_rom, Q1.(width-1), through mult) on the way;
+// the window is picked per frame: 0 rectangular, 1 Hann, 2 Hamming,
+// 3 Blackman-Harris. RAM read plus the multiply register put the load two
+// cycles behind count.
+// real_input = 1 packs two samples per word, {x[2n], x[2n+1]}, so a frame
+// is N/2 words (and needs two coefficients per word)
+// Samples are sample_bits wide and coded per sample_coding (see Extend); the
+// RAM keeps them as they came and they are converted on the way out.
+//
+// The sample RAM is a ring of the last N samples. Each transaction brings
+// hop new samples (1 to N, even with real_input; fft_spi counts them); the
+// frame is the N most recent, read from frame_base, the oldest, onwards.
+// hop < N gives overlapping frames (N/2 for 50%, N/4 for 75%) at hop / N of
+// the input traffic; the first frames after reset still hold the RAM's old
+// contents. The next hop overwrites the oldest samples of the frame before
+// it, so the MCU must not start writing it until that frame has been loaded
+// into the core (load_ready; status busy clear is a safe sign of that).
+// size is log2 of the frame size in samples (up to N), taken per frame: a
+// smaller frame is the n most recent samples, with the window stretched to
+// it by stepping the N-point table N/n at a time.
+module fft_in_flop #(parameter N=512, width=16, real_input=0, sample_bits=8, sample_coding=0)(
+    input logic clk, sck, reset,
+    input logic sample_write,
+    input logic [$clog2(N)-1:0] sample_index,
+    input logic [sample_bits-1:0] sample,
+    input logic [1:0] window,
+    input logic [3:0] size,
+    input logic fft_processing, fft_loaded, fft_done,
+
+    output logic [2*width-1:0] fft_in_word,
+    output logic fft_load, fft_start,
+    output logic [$clog2(N >> real_input)-1:0] idx
+);
+    localparam WORDS = N >> real_input;
+    localparam M = $clog2(WORDS);
+
+    typedef enum logic {WAIT, SEND} state;
+    state currState, nextState;
+
+    logic [M:0] count, words;
+    logic sendReady;
+    logic [1:0] frame_window;
+    logic [3:0] frame_shift;                 // log2(N / n)
+    logic word_write;
+    logic [M-1:0] word_address, word_gray, written, frame_base;
+    logic [1:0][M-1:0] gray_sync;
+    logic [sample_bits*(1+real_input)-1:0] word_d, word_q;
+    logic [2*width-1:0] padded, windowed;
+
+    assign sendReady = (!fft_processing) && fft_loaded && (!fft_done);
+
+    always_ff @(posedge clk) begin
+        if (reset || currState == WAIT) count <= 0;
+        else if (count < words) count <= count + 1;
+    end
+
+    // the write position crosses from sck in Gray code, so a sample taken
+    // while it moves is the old or the new position, never a mix
+    always_ff @(posedge clk)
+        gray_sync <= {gray_sync[0], word_gray};
+
+    // Gray to binary
+    always_comb
+        for (int i = 0; i < M; i++)
+            written[i] = ^(gray_sync[1] >> i);
+
+    // the frame is the last 'words' written: the oldest is that far behind
+    // the next write. fft_loaded takes longer to arrive than the position,
+    // so the position is current by the time the frame is taken
+    always_ff @(posedge clk) begin
+        if (reset) currState <= WAIT; else currState <= nextState;
+        if (currState == WAIT) begin
+            frame_window <= window;
+            frame_shift  <= $clog2(N) - size;
+            frame_base   <= written - (WORDS >> ($clog2(N) - size));
+        end
+    end
+
+    assign words = WORDS >> frame_shift;
+
+    always_comb begin
+        nextState = currState;
+        case (currState)
+            WAIT: if (sendReady && count != words) nextState = SEND;
+            SEND: if (count == words-1) nextState = WAIT;
+        endcase
+    end
+
+    // SEND is only entered while the core is idle; the streaming core may
+    // raise processing again mid-frame, so it must not cut the load short.
+    // The first word reaches the core three cycles after the cycle that saw
+    // fft_processing low (the state register and these two stages).
+    delay #(M+2, 2) load_delay(clk, {currState == SEND, count == words, count[M-1:0]}, {fft_load, fft_start, idx});
+
+    // next ring position, and the same in Gray code for clk
+    always_ff @(posedge sck) begin
+        if (reset) begin
+            word_address <= 0;
+            word_gray    <= 0;
+        end else if (word_write) begin
+            word_address <= word_address + 1'b1;
+            word_gray    <= (word_address + 1'b1) ^ ((word_address + 1'b1) >> 1);
+        end
+    end
+
+    ram_2clk #(WORDS, sample_bits*(1+real_input)) samples(sck, clk, word_write, word_address, frame_base + count[M-1:0],
+                                                          word_d, word_q);
+
+    // sample to 2*width-bit PADDING, then the window
+    generate
+        if (real_input) begin
+            logic [sample_bits-1:0] even_sample;
+            logic [2*width-1:0] even_word, odd_word;
+            logic [width-1:0] even_coeff, odd_coeff;
+
+            // hold x[2n] until x[2n+1] completes the word
+            always_ff @(posedge sck)
+                if (sample_write && !sample_index[0]) even_sample <= sample;
+
+            assign word_write   = sample_write && sample_index[0];
+            assign word_d       = {even_sample, sample};
+
+            Extend #(width, sample_bits, sample_coding) extend_even(.a(word_q[2*sample_bits-1:sample_bits]), .b(even_word));
+            Extend #(width, sample_bits, sample_coding) extend_odd(.a(word_q[sample_bits-1:0]), .b(odd_word));
+            assign padded = {even_word[2*width-1:width], odd_word[2*width-1:width]};
+
+            window_rom #(N, width) even_window(clk, frame_window, {count[M-1:0], 1'b0} << frame_shift, even_coeff);
+            window_rom #(N, width) odd_window(clk, frame_window, {count[M-1:0], 1'b1} << frame_shift, odd_coeff);
+            mult #(width) even_mult(padded[2*width-1:width], even_coeff, windowed[2*width-1:width]);
+            mult #(width) odd_mult(padded[width-1:0], odd_coeff, windowed[width-1:0]);
+        end else begin
+            logic [width-1:0] coeff;
+
+            assign word_write   = sample_write;
+            assign word_d       = sample;
+
+            Extend #(width, sample_bits, sample_coding) extend(.a(word_q), .b(padded));
+
+            // the imaginary part is zero
+            window_rom #(N, width) sample_window(clk, frame_window, count[M-1:0] << frame_shift, coeff);
+            mult #(width) window_mult(padded[2*width-1:width], coeff, windowed[2*width-1:width]);
+            assign windowed[width-1:0] = padded[width-1:0];
+        end
+    endgenerate
+
+    always_ff @(posedge clk)
+        fft_in_word <= windowed;
+endmodule
+
+// Output Buffer: formatted result words -> result RAM -> SPI
+// Two banks of N words: the core drains a frame into one while the SPI reads
+// the last complete frame from the other. The RAM is written on clk and read
+// on sck; the bank, and with it the frame's format (read_format, for the
+// SPI's word size), is picked once per transaction when the fetch wraps to
+// word 0. With bfp the frame's exponent goes out first, in a word of its own.
+// Only the first frame_words words of a frame (N at most, taken with
+// fft_start) are kept, so a core that drains more (half-spectrum output)
+// just has the rest dropped. Words past the end read as zero.
+// The streaming core drains frames back to back, so fft_start for the next
+// frame can come with the last word of this one: that word still counts,
+// and the new frame's exponent, format and size go to the bank it will fill.
+// buf_ready rises as a bank fills and falls with the next fft_start, or a
+// cycle later when the two coincide, so every frame gives it an edge.
+module fft_out_flop #(parameter N=512, width=16, bfp=0)(
+    input logic clk, sck, reset,
+    input logic [2*width-1:0] fft_out_word,
+    input logic [3:0] fft_exponent,
+    input logic [2:0] fft_format,
+    input logic fft_start, fft_done,
+    input logic [$clog2(N):0] frame_words,
+    input logic [$clog2(N)+1:0] out_word,
+
+    output logic [2*width-1:0] out_data,
+    output logic [2:0] read_format,
+    output logic buf_ready
+);
+    localparam M = $clog2(N);
+
+    logic [M:0] cnt, words;
+    logic [1:0][M:0] bank_words;
+    logic write_bank, ready_bank, read_bank, first_word, exponent_next, past_end;
+    logic filled, start_bank, restart;
+    logic [1:0][3:0] exponent;
+    logic [1:0][2:0] bank_format;
+    logic [$clog2(N)+1:0] last_word;
+    logic [M-1:0] read_offset;
+    logic [2:0] word_format;
+    logic [2*width-1:0] ram_q, exponent_word;
+
+    always_ff @(posedge clk) begin
+        if (reset || fft_start) cnt <= 0;
+        else if (fft_done && cnt < words) cnt <= cnt + 1;
+    end
+
+    // a bank becomes readable once all its words are in
+    assign filled     = fft_done && cnt == words-1;
+    assign start_bank = filled ? ~write_bank : write_bank;
+
+    always_ff @(posedge clk) begin
+        if (reset) begin
+            write_bank <= 0;
+            ready_bank <= 0;
+            exponent <= 0;
+            bank_format <= 0;
+            bank_words <= {2{(M+1)'(N)}};
+            words <= N;
+            buf_ready <= 0;
+            restart <= 0;
+        end else begin
+            if (fft_start) begin
+                exponent[start_bank] <= fft_exponent;
+                bank_format[start_bank] <= fft_format;
+                bank_words[start_bank] <= frame_words;
+                words <= frame_words;
+            end
+            if (filled) begin
+                ready_bank <= write_bank;
+                write_bank <= ~write_bank;
+            end
+            restart <= filled && fft_start;
+            if (filled)                    buf_ready <= 1;
+            else if (fft_start || restart) buf_ready <= 0;
+        end
+    end
+
+    assign first_word  = (out_word == 0) && (last_word != 0);
+    assign read_offset = out_word - bfp;
+    assign word_format = first_word ? bank_format[ready_bank] : read_format;
+
+    always_ff @(posedge sck) begin
+        if (reset) begin
+            last_word <= 0;
+            read_bank <= 0;
+            read_format <= 0;
+        end else begin
+            last_word <= out_word;
+            if (first_word) begin
+                read_bank <= ready_bank;
+                read_format <= bank_format[ready_bank];
+            end
+        end
+        exponent_next <= bfp && (out_word == 0);
+        past_end      <= (out_word >= bank_words[first_word ? ready_bank : read_bank] + bfp);
+        // zero-extended in a word of the frame's size, left-aligned like the results
+        exponent_word <= exponent[first_word ? ready_bank : read_bank] <<
+                         ((word_format == 1 || word_format == 2) ? 2*width-16 : (word_format == 3) ? 2*width-8 : 0);
+    end
+
+    ram_2clk #(2 << M, 2*width) results(clk, sck, fft_done && cnt < words, {write_bank, cnt[M-1:0]},
+                                        {first_word ? ready_bank : read_bank, read_offset},
+                                        fft_out_word, ram_q);
+
+    assign out_data  = past_end ? '0 : exponent_next ? exponent_word : ram_q;
+endmodule
+
+// bits-bit sample as the real part of a {re, im} word. coding 0 takes it as
+// unsigned, 1 as offset binary (an ADC's midscale becomes zero) and 2 as
+// two's complement. Samples with more than width - 1 signed bits drop LSBs
+// to fit, so a full-scale load stays within FS/2, as bfp assumes.
+module Extend #(parameter width=16, bits=8, coding=0)(input logic [bits-1:0] a, output logic [2*width-1:0] b);
+    localparam S    = (coding == 0) ? bits + 1 : bits;    // signed bits
+    localparam DROP = (S > width - 1) ? S - (width - 1) : 0;
+
+    logic signed [S-1:0] value;
+
+    generate
+        if (coding == 0)      assign value = {1'b0, a};
+        else if (coding == 1) assign value = {~a[bits-1], a[bits-2:0]};
+        else                  assign value = a;
+    endgenerate
+
+    assign b = {width'(value >>> DROP), {width{1'b0}}};
+endmodule
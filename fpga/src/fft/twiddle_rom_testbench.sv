@@ -0,0 +1,116 @@
+// Checks the octant-compressed twiddle ROM against the full table, entry by
+// entry, for the smallest, default and largest N, and prints the SNR of the
+// CORDIC generator against the table for a few iteration counts
+module twiddle_rom_testbench();
+
+   logic       clk;
+   logic [6:0] finished;
+
+   // clk
+   always
+     begin
+	    clk = 1; #5; clk=0; #5;
+     end
+
+   twiddle_rom_check #(64)   check_64(clk, finished[0]);
+   twiddle_rom_check #(512)  check_512(clk, finished[1]);
+   twiddle_rom_check #(4096) check_4096(clk, finished[2]);
+
+   twiddle_cordic_check #(4096, 16, 10) cordic_10(clk, finished[3]);
+   twiddle_cordic_check #(4096, 16, 12) cordic_12(clk, finished[4]);
+   twiddle_cordic_check #(4096, 16, 14) cordic_14(clk, finished[5]);
+   twiddle_cordic_check #(4096, 16, 16) cordic_16(clk, finished[6]);
+
+   always @(posedge clk)
+     if (&finished) begin
+	$display("Twiddle ROM test complete.");
+	$stop;
+     end
+endmodule // twiddle_rom_testbench
+
+// Sweeps every address through both ROMs and reports any difference
+module twiddle_rom_check #(parameter N=512, width=16)
+   (input logic clk,
+    output logic finished);
+
+   logic [$clog2(N)-2:0] address, address_q;
+   logic [2*width-1:0]   full, octant;
+   logic                 checking;
+   integer               errors;
+
+   twiddle_rom #(N, width, 0) full_rom(clk, address, full);
+   twiddle_rom #(N, width, 1) octant_rom(clk, address, octant);
+
+   initial
+     begin
+	address = 0; checking = 0; finished = 0; errors = 0;
+     end
+
+   // both ROMs answer one cycle after the address
+   always @(posedge clk)
+     if (!finished) begin
+	address <= address + 1;
+	address_q <= address;
+	checking <= 1;
+	if (checking) begin
+	   if (octant !== full) begin
+	      $display("Error (N = %0d) @ address %d: expected %h, got %h", N, address_q, full, octant);
+	      errors = errors + 1;
+	   end
+	   if (address_q == N/2 - 1) begin
+	      $display("N = %0d: %0d twiddles checked, %0d errors", N, N/2, errors);
+	      finished <= 1;
+	   end
+	end
+     end
+endmodule // twiddle_rom_check
+
+// Sweeps every address through the table and the CORDIC generator and
+// reports the twiddle SNR and the largest error. The CORDIC is pipelined,
+// so the table reads the same address LATENCY - 1 cycles later.
+module twiddle_cordic_check #(parameter N=512, width=16, iterations=14)
+   (input logic clk,
+    output logic finished);
+
+   // twiddle_rom's latency with CORDIC
+   localparam LATENCY = 1 + (iterations - 1) / 2;
+
+   logic [$clog2(N)-2:0]    address, full_address, address_q;
+   logic [2*width-1:0]      full, rotated;
+   logic signed [width-1:0] full_re, full_im, rotated_re, rotated_im;
+   logic                    checking;
+   real                     signal, noise;
+   integer                  error_re, error_im, worst;
+
+   delay #($clog2(N)-1, LATENCY-1) align(clk, address, full_address);
+   twiddle_rom #(N, width, 0) full_rom(clk, full_address, full);
+   twiddle_rom #(N, width, 1, iterations) cordic_rom(clk, address, rotated);
+
+   assign {full_re, full_im} = full;
+   assign {rotated_re, rotated_im} = rotated;
+
+   initial
+     begin
+	address = 0; checking = 0; finished = 0; signal = 0; noise = 0; worst = 0;
+     end
+
+   always @(posedge clk)
+     if (!finished) begin
+	address <= address + 1;
+	address_q <= full_address;
+	if (address == LATENCY - 1) checking <= 1;
+	if (checking) begin
+	   error_re = rotated_re - full_re;
+	   error_im = rotated_im - full_im;
+	   signal = signal + $itor(full_re) * full_re + $itor(full_im) * full_im;
+	   noise = noise + $itor(error_re) * error_re + $itor(error_im) * error_im;
+	   if (error_re > worst || -error_re > worst) worst = (error_re < 0) ? -error_re : error_re;
+	   if (error_im > worst || -error_im > worst) worst = (error_im < 0) ? -error_im : error_im;
+	   if (address_q == N/2 - 1) begin
+	      $display("N = %0d, %0d CORDIC iterations: twiddle SNR %0.1f dB, max error %0d LSB",
+		       N, iterations, 10 * $log10(signal / noise), worst);
+	      finished <= 1;
+	   end
+	end
+     end
+endmodule // twiddle_cordic_check
@@ -0,0 +1,122 @@
+// FPGA_FFT.c
+// Command link to the FPGA FFT over SPI (or QUADSPI)
+
+#include "FPGA_FFT.h"
+#include "STM32L432KC_GPIO.h"
+#ifdef FFT_LINK_QSPI
+#include "STM32L432KC_QSPI.h"
+#else
+#include "STM32L432KC_SPI.h"
+#endif
+
+#ifndef FFT_LINK_QSPI
+// One transaction: CS low, the command, optionally a dummy byte, then the data
+static void fftTransfer(uint8_t command, int dummy, const uint8_t *send, uint8_t *receive, int length){
+    digitalWrite(SPI_CS, PIO_LOW);
+    spiSendReceive(command);
+    if (dummy) spiSendReceive(0);
+    for (int i = 0; i < length; i++) {
+        char data = spiSendReceive(send ? send[i] : 0);
+        if (receive) receive[i] = data;
+    }
+    // wait for the last byte to leave before raising CS
+    while(SPI1->SR & SPI_SR_BSY);
+    digitalWrite(SPI_CS, PIO_HIGH);
+}
+#endif
+
+void initFFT(void){
+#ifndef FFT_LINK_QSPI
+    // the FPGA starts a transaction on every falling edge of CS
+    digitalWrite(SPI_CS, PIO_HIGH);
+#endif
+}
+
+void fftSetMode(uint8_t mode){
+#ifdef FFT_LINK_QSPI
+    qspiWrite(FFT_SET_MODE, &mode, 1);
+#else
+    fftTransfer(FFT_SET_MODE, 0, &mode, 0, 1);
+#endif
+}
+
+void fftSetSize(int log2n){
+    uint8_t size = log2n;
+#ifdef FFT_LINK_QSPI
+    qspiWrite(FFT_SET_SIZE, &size, 1);
+#else
+    fftTransfer(FFT_SET_SIZE, 0, &size, 0, 1);
+#endif
+}
+
+uint16_t fftReadStatus(void){
+    uint8_t status[2];
+#ifdef FFT_LINK_QSPI
+    qspiRead(FFT_READ_STATUS, status, 2);
+#else
+    fftTransfer(FFT_READ_STATUS, 1, 0, status, 2);
+#endif
+    return (status[0] << 8) | status[1];
+}
+
+void fftWriteFrame(const uint8_t *samples, int length){
+#ifdef FFT_LINK_QSPI
+    qspiWrite(FFT_WRITE_FRAME, samples, length);
+#else
+    fftTransfer(FFT_WRITE_FRAME, 0, samples, 0, length);
+#endif
+}
+
+int fftPackSamples(const uint16_t *samples, int count, int bits, uint8_t *packed){
+    uint32_t buffer = 0; // bits not yet packed, right-aligned
+    int pending = 0, length = 0;
+    for (int i = 0; i < count; i++) {
+        buffer = (buffer << bits) | (samples[i] & ((1 << bits) - 1));
+        pending += bits;
+        while (pending >= 8) {
+            pending -= 8;
+            packed[length++] = buffer >> pending;
+        }
+    }
+    // pad the last byte with zeros
+    if (pending) packed[length++] = buffer << (8 - pending);
+    return length;
+}
+
+void fftReadResults(uint8_t *results, int length){
+#ifdef FFT_LINK_QSPI
+    qspiRead(FFT_READ_RESULTS, results, length);
+#else
+    fftTransfer(FFT_READ_RESULTS, 1, 0, results, length);
+#endif
+}
+
+void fftWaitReady(void){
+    while(!(fftReadStatus() & FFT_STATUS_READY));
+}
+
+volatile int fftDone;
+volatile uint32_t fftDoneTime;
+static TIM_TypeDef * doneTimer;
+
+void initFFTDone(TIM_TypeDef * timer){
+    doneTimer = timer;
+    fftDone = 0;
+    gpioEnable(gpioPinToPort(FFT_DONE));
+    pinMode(FFT_DONE, GPIO_INPUT);
+    pinInterrupt(FFT_DONE, GPIO_RISING_EDGE);
+}
+
+uint32_t fftWaitDone(void){
+    while(!fftDone) __WFI();
+    fftDone = 0;
+    return fftDoneTime;
+}
+
+void EXTI9_5_IRQHandler(void){
+    if (pinInterruptPending(FFT_DONE)) {
+        if (doneTimer) fftDoneTime = doneTimer->CNT;
+        fftDone = 1;
+        pinClearInterrupt(FFT_DONE);
+    }
+}
@@ -0,0 +1,96 @@
+// FPGA_FFT.h
+// Header for the command link to the FPGA FFT (fft_spi)
+
+#ifndef FPGA_FFT_H
+#define FPGA_FFT_H
+
+#include <stdint.h>
+#include <stm32l432xx.h>
+
+// the FPGA's done line: rises as each frame of results lands in its output buffer
+#define FFT_DONE PA8
+
+// Define FFT_LINK_QSPI to talk to a quad = 1 build over QUADSPI instead of SPI
+
+// commands (the first byte of every transaction)
+#define FFT_WRITE_FRAME  0x01 // then the frame's samples
+#define FFT_READ_RESULTS 0x02 // a dummy byte, then the result words
+#define FFT_READ_STATUS  0x03 // a dummy byte, then two status bytes
+#define FFT_SET_MODE     0x04 // then the mode byte
+#define FFT_SET_SIZE     0x05 // then log2 of the frame size
+
+// status bits
+#define FFT_STATUS_READY         (1 << 0) // a frame completed since the last result read
+#define FFT_STATUS_BUSY          (1 << 1) // a frame is waiting for or in the core
+#define FFT_STATUS_FRAMES(status) ((status) >> 8) // frames completed, mod 256
+
+// mode byte: format (0-7), window (0-3), averaging (0-3), inverse (0-1)
+// formats 5-7 return only the band energies (mel, 1/3-octave, linear), one
+// power-sized word (2*width bits) per band; smaller frames (fftSetSize) get
+// power, as format 4, instead. They need a build with bands > 0 (otherwise
+// they are power, like 4), and averaging one with accumulate = 1. Neither is in the default build. Frames are real
+// samples, so inverse transforms those; it cannot turn a spectrum back into
+// samples.
+#define FFT_MODE(format, window, averaging, inverse) \
+    (((format) << 5) | ((window) << 3) | ((averaging) << 1) | (inverse))
+
+///////////////////////////////////////////////////////////////////////////////
+// Function prototypes
+///////////////////////////////////////////////////////////////////////////////
+
+/* Idles the link (chip select high); call after initSPI or initQSPI. */
+void initFFT(void);
+
+/* Sets the mode register; takes effect from the next frame.
+ *    -- mode: e.g. FFT_MODE(3, 1, 0, 0) for log-magnitude with a Hann window */
+void fftSetMode(uint8_t mode);
+
+/* Sets the frame size for the frames written after it; call with no frame
+ * in flight. Frames are then n samples (hop * n / N per fftWriteFrame) and
+ * come back as n result words (n/2 + 1 for real or half-spectrum builds).
+ *    -- log2n: 6 (64 points) up to log2(N); others are ignored, and so are
+ *       sizes where hop * n / N would not be a whole (real builds: even)
+ *       number of samples */
+void fftSetSize(int log2n);
+
+/* Reads the status register.
+ *    -- return: {frame count, 6'b0, busy, ready} */
+uint16_t fftReadStatus(void);
+
+/* Sends one frame (hop samples), already packed (see fftPackSamples).
+ * With hop < N, wait for FFT_STATUS_BUSY to clear before sending the next
+ * one: its samples overwrite the oldest ones of the frame still waiting.
+ *    -- samples: the packed sample bytes
+ *    -- length: number of bytes */
+void fftWriteFrame(const uint8_t *samples, int length);
+
+/* Packs samples back to back, MSB first, as the FPGA's sample_bits expects
+ * (8, 12 or 16), e.g. straight ADC readings with sample_coding = 0 or 1.
+ *    -- samples: the samples, right-aligned
+ *    -- count: number of samples
+ *    -- bits: bits per sample on the wire
+ *    -- packed: room for (count * bits + 7) / 8 bytes
+ *    -- return: number of bytes packed */
+int fftPackSamples(const uint16_t *samples, int count, int bits, uint8_t *packed);
+
+/* Reads the latest complete frame's results, MSB first.
+ *    -- results: where to put the bytes received
+ *    -- length: number of bytes (words x the format's word size) */
+void fftReadResults(uint8_t *results, int length);
+
+/* Polls the status until a new frame of results is ready. */
+void fftWaitReady(void);
+
+/* Takes the done line as a rising-edge interrupt (EXTI9_5_IRQHandler), which
+ * sets fftDone and stamps fftDoneTime.
+ *    -- timer: a running timer whose count is the timestamp (0 for none) */
+void initFFTDone(TIM_TypeDef * timer);
+
+/* Sleeps until the done interrupt, then clears it.
+ *    -- return: the timer count when the results landed */
+uint32_t fftWaitDone(void);
+
+extern volatile int fftDone;           // set by the done interrupt
+extern volatile uint32_t fftDoneTime;  // timer count at the done interrupt
+
+#endif
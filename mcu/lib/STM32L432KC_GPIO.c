@@ -117,4 +117,39 @@ void togglePin(int gpio_pin) {
 
 	// Use XOR to toggle
 	GPIO_PORT_PTR->ODR ^= (1 << pin_offset);
-}
\ No newline at end of file
+}
+
+/* Routes a pin to its EXTI line and enables the line's interrupt. The
+ * handler (EXTI0_IRQHandler ... EXTI4_IRQHandler, EXTI9_5_IRQHandler or
+ * EXTI15_10_IRQHandler, by pin number) has to clear it with pinClearInterrupt().
+ *    -- pin: a GPIO pin ID, e.g. PA8 (one port per pin number)
+ *    -- edge: GPIO_RISING_EDGE, GPIO_FALLING_EDGE or GPIO_BOTH_EDGES */
+void pinInterrupt(int gpio_pin, int edge) {
+	int pin_offset = gpioPinOffset(gpio_pin);
+
+	// Select the pin's port for its EXTI line
+	RCC->APB2ENR |= RCC_APB2ENR_SYSCFGEN;
+	SYSCFG->EXTICR[pin_offset / 4] &= ~(0xF << 4*(pin_offset % 4));
+	SYSCFG->EXTICR[pin_offset / 4] |= (gpioPinToPort(gpio_pin) << 4*(pin_offset % 4));
+
+	// Edges to trigger on
+	if (edge == GPIO_RISING_EDGE || edge == GPIO_BOTH_EDGES) EXTI->RTSR1 |= (1 << pin_offset);
+	else EXTI->RTSR1 &= ~(1 << pin_offset);
+	if (edge == GPIO_FALLING_EDGE || edge == GPIO_BOTH_EDGES) EXTI->FTSR1 |= (1 << pin_offset);
+	else EXTI->FTSR1 &= ~(1 << pin_offset);
+
+	// Unmask the line and enable its interrupt
+	EXTI->IMR1 |= (1 << pin_offset);
+	if (pin_offset < 5)       NVIC_EnableIRQ((IRQn_Type) (EXTI0_IRQn + pin_offset));
+	else if (pin_offset < 10) NVIC_EnableIRQ(EXTI9_5_IRQn);
+	else                      NVIC_EnableIRQ(EXTI15_10_IRQn);
+}
+
+int pinInterruptPending(int gpio_pin) {
+	return (EXTI->PR1 >> gpioPinOffset(gpio_pin)) & 1;
+}
+
+void pinClearInterrupt(int gpio_pin) {
+	// Write 1 to clear
+	EXTI->PR1 = (1 << gpioPinOffset(gpio_pin));
+}
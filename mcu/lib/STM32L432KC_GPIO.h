@@ -31,6 +31,11 @@
 #define GPIO_PULL_DOWN 1 // Arbitrary ID for a pull-down resistor
 #define GPIO_FLOATING  2 // Arbitrary ID for a floating pin (neither resistor is active)
 
+// Values which "edge" can take on in pinInterrupt()
+#define GPIO_RISING_EDGE  0 // Interrupt on a rising edge
+#define GPIO_FALLING_EDGE 1 // Interrupt on a falling edge
+#define GPIO_BOTH_EDGES   2 // Interrupt on either edge
+
 // Pin definitions for every GPIO pin
 #define PA0    0
 #define PA1    1
@@ -105,4 +110,10 @@ void digitalWrite(int gpio_pin, int val);
 
 void togglePin(int gpio_pin);
 
+void pinInterrupt(int gpio_pin, int edge);
+
+int pinInterruptPending(int gpio_pin);
+
+void pinClearInterrupt(int gpio_pin);
+
 #endif
\ No newline at end of file
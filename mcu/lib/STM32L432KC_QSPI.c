@@ -0,0 +1,81 @@
+// STM32L432KC_QSPI.c
+// QUADSPI functions to initialize and write/read in indirect mode
+
+#include "STM32L432KC_QSPI.h"
+#include "STM32L432KC_GPIO.h"
+
+static int qspiDummy;
+
+void initQSPI(int prescaler, int dummy){
+    RCC->AHB2ENR |= (RCC_AHB2ENR_GPIOAEN | RCC_AHB2ENR_GPIOBEN);
+    // QUADSPI clock
+    RCC->AHB3ENR |= RCC_AHB3ENR_QSPIEN;
+
+    // pin Modes
+    pinMode(QSPI_CLK, GPIO_ALT);
+    pinMode(QSPI_NCS, GPIO_ALT);
+    pinMode(QSPI_IO0, GPIO_ALT);
+    pinMode(QSPI_IO1, GPIO_ALT);
+    pinMode(QSPI_IO2, GPIO_ALT);
+    pinMode(QSPI_IO3, GPIO_ALT);
+
+    // Very high speed on the clock and data pins
+    GPIOA->OSPEEDR |= (GPIO_OSPEEDR_OSPEED3 | GPIO_OSPEEDR_OSPEED6 | GPIO_OSPEEDR_OSPEED7);
+    GPIOB->OSPEEDR |= (GPIO_OSPEEDR_OSPEED0 | GPIO_OSPEEDR_OSPEED1);
+
+    // Set AF10 (PA2, PA3, PA6, PA7 in AFRL of port A; PB0, PB1 in AFRL of port B)
+    GPIOA->AFR[0] &= ~(GPIO_AFRL_AFSEL2 | GPIO_AFRL_AFSEL3 | GPIO_AFRL_AFSEL6 | GPIO_AFRL_AFSEL7);
+    GPIOA->AFR[0] |= _VAL2FLD(GPIO_AFRL_AFSEL2, 10);
+    GPIOA->AFR[0] |= _VAL2FLD(GPIO_AFRL_AFSEL3, 10);
+    GPIOA->AFR[0] |= _VAL2FLD(GPIO_AFRL_AFSEL6, 10);
+    GPIOA->AFR[0] |= _VAL2FLD(GPIO_AFRL_AFSEL7, 10);
+    GPIOB->AFR[0] &= ~(GPIO_AFRL_AFSEL0 | GPIO_AFRL_AFSEL1);
+    GPIOB->AFR[0] |= _VAL2FLD(GPIO_AFRL_AFSEL0, 10);
+    GPIOB->AFR[0] |= _VAL2FLD(GPIO_AFRL_AFSEL1, 10);
+
+    // QUADSPI configuration
+    QUADSPI->CR = _VAL2FLD(QUADSPI_CR_PRESCALER, prescaler); // Set clock prescaler, FIFO threshold 1 byte
+    QUADSPI->DCR = _VAL2FLD(QUADSPI_DCR_FSIZE, 31);          // No memory behind it: allow any length
+    // CKMODE = 0: clock low between transactions (the FPGA drives on the falling edge)
+    qspiDummy = dummy;
+
+    QUADSPI->CR |= (QUADSPI_CR_EN); // Enable QUADSPI
+}
+
+// Instruction and data on four lines, no address or alternate bytes
+static void qspiStart(int fmode, int dummy, uint8_t instruction, int length){
+    while(QUADSPI->SR & QUADSPI_SR_BUSY);
+    QUADSPI->DLR = length - 1;
+    // writing the instruction starts the transfer
+    QUADSPI->CCR = _VAL2FLD(QUADSPI_CCR_FMODE, fmode) |
+                   _VAL2FLD(QUADSPI_CCR_DMODE, 0b11) |
+                   _VAL2FLD(QUADSPI_CCR_DCYC, dummy) |
+                   _VAL2FLD(QUADSPI_CCR_IMODE, 0b11) |
+                   _VAL2FLD(QUADSPI_CCR_INSTRUCTION, instruction);
+}
+
+// Wait for the last byte, then clear the transfer complete flag
+static void qspiFinish(void){
+    while(!(QUADSPI->SR & QUADSPI_SR_TCF));
+    QUADSPI->FCR = QUADSPI_FCR_CTCF;
+}
+
+void qspiWrite(uint8_t instruction, const uint8_t *data, int length){
+    qspiStart(0b00, 0, instruction, length); // indirect write
+    for (int i = 0; i < length; i++) {
+        // room in the FIFO
+        while(!(QUADSPI->SR & QUADSPI_SR_FTF));
+        *(volatile uint8_t *) (&QUADSPI->DR) = data[i];
+    }
+    qspiFinish();
+}
+
+void qspiRead(uint8_t instruction, uint8_t *data, int length){
+    qspiStart(0b01, qspiDummy, instruction, length); // indirect read
+    for (int i = 0; i < length; i++) {
+        // a byte in the FIFO
+        while(!(QUADSPI->SR & (QUADSPI_SR_FTF | QUADSPI_SR_TCF)));
+        data[i] = *(volatile uint8_t *) (&QUADSPI->DR);
+    }
+    qspiFinish();
+}
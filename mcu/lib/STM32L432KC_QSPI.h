@@ -0,0 +1,42 @@
+// STM32L432KC_QSPI.h
+// Header for QUADSPI functions (the FPGA's fft_spi on four lanes)
+
+#ifndef STM32L4_QSPI_H
+#define STM32L4_QSPI_H
+
+#include <stdint.h>
+#include <stm32l432xx.h>
+
+// define pins (all AF10); IO0 shares PB1 with SPI_CS, so use one link or the other
+
+#define QSPI_CLK PA3
+#define QSPI_NCS PA2
+#define QSPI_IO0 PB1
+#define QSPI_IO1 PB0
+#define QSPI_IO2 PA7
+#define QSPI_IO3 PA6
+
+///////////////////////////////////////////////////////////////////////////////
+// Function prototypes
+///////////////////////////////////////////////////////////////////////////////
+
+/* Enables the QUADSPI peripheral in indirect mode with instruction and data on
+ * all four lines, no address, and the clock low when idle.
+ *    -- prescaler: (0 - 255). The QUADSPI clk will be the AHB clock / (prescaler + 1).
+ *    -- dummy: turnaround clocks between the instruction and read data (the FPGA's
+ *          link answers after one dummy byte: 2 clocks) */
+void initQSPI(int prescaler, int dummy);
+
+/* Sends an instruction followed by length bytes, four bits per clock.
+ *    -- instruction: e.g. FFT_WRITE_FRAME
+ *    -- data: the bytes to send, MSB nibble first
+ *    -- length: number of bytes (1 or more) */
+void qspiWrite(uint8_t instruction, const uint8_t *data, int length);
+
+/* Sends an instruction, waits the dummy clocks and reads length bytes.
+ *    -- instruction: e.g. FFT_READ_RESULTS
+ *    -- data: where to put the bytes received
+ *    -- length: number of bytes (1 or more) */
+void qspiRead(uint8_t instruction, uint8_t *data, int length);
+
+#endif